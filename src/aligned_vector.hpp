@@ -0,0 +1,192 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+template <class T>
+class column_span {
+    T* data_{nullptr};
+    size_t size_{0};
+
+  public:
+    constexpr column_span() = default;
+    constexpr column_span(T* data, size_t size) : data_(data), size_(size) {}
+
+    constexpr T* data() const { return data_; }
+    constexpr size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+    constexpr T& operator[](size_t i) const { return data_[i]; }
+    constexpr T* begin() const { return data_; }
+    constexpr T* end() const { return data_ + size_; }
+};
+
+//==================================================================================================
+template <class T, size_t Align = 64>
+class aligned_vector {
+    static_assert(Align >= alignof(void*) and (Align & (Align - 1)) == 0,
+                  "alignment must be a power of two");
+
+    T* data_{nullptr};
+    size_t size_{0};
+    size_t capacity_{0};
+
+    static T* allocate(size_t n) {
+        if (n > (SIZE_MAX - Align) / sizeof(T)) { throw std::bad_alloc(); }
+        void* raw = std::malloc(n * sizeof(T) + Align);
+        if (raw == nullptr) { throw std::bad_alloc(); }
+        auto aligned = (reinterpret_cast<uintptr_t>(raw) + Align) & ~uintptr_t(Align - 1);
+        reinterpret_cast<void**>(aligned)[-1] = raw;
+        return reinterpret_cast<T*>(aligned);
+    }
+
+    static void deallocate(T* p) {
+        if (p != nullptr) { std::free(reinterpret_cast<void**>(p)[-1]); }
+    }
+
+    void grow_to(size_t n) {
+        if (n > capacity_) { reserve(n > 2 * capacity_ ? n : 2 * capacity_); }
+    }
+
+  public:
+    static constexpr size_t alignment = Align;
+
+    aligned_vector() = default;
+    explicit aligned_vector(size_t n) {
+        try {
+            resize(n);
+        } catch (...) {
+            clear();
+            deallocate(data_);
+            throw;
+        }
+    }
+
+    aligned_vector(const aligned_vector& other) {
+        reserve(other.size_);
+        try {
+            for (; size_ < other.size_; size_++) { new (data_ + size_) T(other.data_[size_]); }
+        } catch (...) {
+            clear();
+            deallocate(data_);
+            throw;
+        }
+    }
+
+    aligned_vector(aligned_vector&& other) noexcept
+        : data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    aligned_vector& operator=(aligned_vector other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        return *this;
+    }
+
+    ~aligned_vector() {
+        clear();
+        deallocate(data_);
+    }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+    T* begin() { return data_; }
+    T* end() { return data_ + size_; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+
+    // the old elements are only destroyed once all of them are in the new buffer, so that a
+    // throwing copy leaves the vector unchanged
+    void reserve(size_t n) {
+        if (n <= capacity_) { return; }
+        T* new_data = allocate(n);
+        size_t built = 0;
+        try {
+            for (; built < size_; built++) {
+                new (new_data + built) T(std::move_if_noexcept(data_[built]));
+            }
+        } catch (...) {
+            for (size_t i = 0; i < built; i++) { new_data[i].~T(); }
+            deallocate(new_data);
+            throw;
+        }
+        for (size_t i = 0; i < size_; i++) { data_[i].~T(); }
+        deallocate(data_);
+        data_ = new_data;
+        capacity_ = n;
+    }
+
+    // grows geometrically like push_back, if a constructor throws the vector keeps the elements
+    // constructed before it
+    void resize(size_t n) {
+        if (n > size_) {
+            grow_to(n);
+            for (; size_ < n; size_++) { new (data_ + size_) T(); }
+        } else {
+            for (size_t i = n; i < size_; i++) { data_[i].~T(); }
+            size_ = n;
+        }
+    }
+
+    void resize(size_t n, const T& value) {
+        if (n > size_) {
+            grow_to(n);
+            for (; size_ < n; size_++) { new (data_ + size_) T(value); }
+        } else {
+            for (size_t i = n; i < size_; i++) { data_[i].~T(); }
+            size_ = n;
+        }
+    }
+
+    void push_back(const T& value) { push_back(T(value)); }
+
+    void push_back(T&& value) {
+        grow_to(size_ + 1);
+        new (data_ + size_) T(std::move(value));
+        size_++;
+    }
+
+    void pop_back() { data_[--size_].~T(); }
+
+    void clear() { resize(0); }
+};
+
+template <class T, size_t Align>
+constexpr size_t aligned_vector<T, Align>::alignment;
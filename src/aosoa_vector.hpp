@@ -0,0 +1,155 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include "soa_vector.hpp"
+
+constexpr size_t block_column_alignment(size_t bytes, size_t min_alignment) {
+    size_t result = 64;
+    while (result > min_alignment and bytes % result != 0) { result /= 2; }
+    return result;
+}
+
+template <class T, size_t BlockSize>
+struct alignas(block_column_alignment(sizeof(T) * BlockSize, alignof(T))) block_column {
+    T values[BlockSize];
+};
+
+//==================================================================================================
+template <class Block, class M>
+struct aosoa_block {
+    Block* block;
+    size_t size;
+
+    template <class Key>
+    auto* get() const {
+        return ::get<map_element_index<Key, M>::value>(*block).values;
+    }
+};
+
+template <class Key, class Block, class M>
+auto* get(const aosoa_block<Block, M>& block) {
+    return block.template get<Key>();
+}
+
+//==================================================================================================
+template <class M, size_t BlockSize = 16>
+class aosoa_vector;
+
+template <class... Keys, class... Values, size_t BlockSize>
+class aosoa_vector<type_map<type_pair<Keys, Values>...>, BlockSize> {
+    static_assert(BlockSize > 0, "block size must be positive");
+
+  public:
+    using map = type_map<type_pair<Keys, Values>...>;
+    using block_type = record_storage<block_column<uncold_t<Values>, BlockSize>...>;
+    static constexpr size_t block_size = BlockSize;
+
+  private:
+    aligned_vector<block_type> blocks;
+    size_t size_{0};
+
+    static size_t blocks_for(size_t n) { return (n + BlockSize - 1) / BlockSize; }
+
+    template <size_t... Is>
+    void push_back(std::index_sequence<Is...>, const uncold_t<Values>&... values) {
+        if (size_ % BlockSize == 0) { blocks.push_back(block_type()); }
+        block_type& b = blocks[size_ / BlockSize];
+        int dummy[] = {(::get<Is>(b).values[size_ % BlockSize] = values, 0)...};
+        (void)dummy;
+        size_++;
+    }
+
+    template <size_t... Is>
+    void reset(size_t i, std::index_sequence<Is...>) {
+        block_type& b = blocks[i / BlockSize];
+        int dummy[] = {(::get<Is>(b).values[i % BlockSize] = uncold_t<Values>(), 0)...};
+        (void)dummy;
+    }
+
+  public:
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t block_count() const { return blocks.size(); }
+
+    void reserve(size_t n) { blocks.reserve(blocks_for(n)); }
+
+    void resize(size_t n) {
+        for (size_t i = size_; i < n and i % BlockSize != 0; i++) {
+            reset(i, std::index_sequence_for<Values...>());
+        }
+        blocks.resize(blocks_for(n));
+        size_ = n;
+    }
+
+    void clear() { resize(0); }
+
+    void push_back(const uncold_t<Values>&... values) {
+        push_back(std::index_sequence_for<Values...>(), values...);
+    }
+
+    template <class Layout>
+    void push_back(const typed_record<map, Layout>& record) {
+        push_back(record.template get<Keys>()...);
+    }
+
+    template <class Key>
+    record_element_t<Key, map>& get(size_t i) {
+        return ::get<map_element_index<Key, map>::value>(blocks[i / BlockSize])
+            .values[i % BlockSize];
+    }
+
+    template <class Key>
+    const record_element_t<Key, map>& get(size_t i) const {
+        return ::get<map_element_index<Key, map>::value>(blocks[i / BlockSize])
+            .values[i % BlockSize];
+    }
+
+    soa_row<aosoa_vector> operator[](size_t i) { return {this, i}; }
+    soa_row<const aosoa_vector> operator[](size_t i) const { return {this, i}; }
+
+    aosoa_block<block_type, map> block(size_t b) {
+        return {&blocks[b], b + 1 < blocks.size() ? BlockSize : size_ - b * BlockSize};
+    }
+
+    aosoa_block<const block_type, map> block(size_t b) const {
+        return {&blocks[b], b + 1 < blocks.size() ? BlockSize : size_ - b * BlockSize};
+    }
+
+    template <class F>
+    void for_each_block(F&& f) {
+        for (size_t b = 0; b < blocks.size(); b++) { f(block(b)); }
+    }
+
+    template <class F>
+    void for_each_block(F&& f) const {
+        for (size_t b = 0; b < blocks.size(); b++) { f(block(b)); }
+    }
+};
+
+template <class... Keys, class... Values, size_t BlockSize>
+constexpr size_t aosoa_vector<type_map<type_pair<Keys, Values>...>, BlockSize>::block_size;
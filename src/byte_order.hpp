@@ -0,0 +1,85 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+enum class byte_order {
+    little,
+    big,
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    native = big
+#else
+    native = little
+#endif
+};
+
+// Only numbers and enums have a byte order, other types (fixed-size strings, structs...) are byte
+// sequences left unchanged.
+template <class T>
+using has_byte_order =
+    std::integral_constant<bool, std::is_arithmetic<T>::value or std::is_enum<T>::value>;
+
+template <class T>
+T byteswap(T value, std::true_type) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    std::reverse(bytes, bytes + sizeof(T));  // recognized as a bswap instruction by gcc and clang
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+template <class T>
+T byteswap(T value, std::false_type) {
+    return value;
+}
+
+template <class T>
+T byteswap(T value) {
+    static_assert(std::is_trivially_copyable<T>::value, "byteswap needs a trivially copyable type");
+    return byteswap(value, has_byte_order<T>());
+}
+
+// unaligned-safe load and store of a value stored with the given byte order
+template <class T, byte_order order = byte_order::native>
+T load_bytes(const void* p) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "load_bytes needs a trivially copyable type");
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return order == byte_order::native ? value : byteswap(value);
+}
+
+template <class T, byte_order order = byte_order::native>
+void store_bytes(void* p, T value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "store_bytes needs a trivially copyable type");
+    if (order != byte_order::native) { value = byteswap(value); }
+    std::memcpy(p, &value, sizeof(T));
+}
@@ -0,0 +1,69 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include "type_map.hpp"
+
+template <class T>
+struct cold {};
+
+template <class T>
+struct is_cold : std::false_type {};
+
+template <class T>
+struct is_cold<cold<T>> : std::true_type {};
+
+template <class T>
+struct uncold : is_type<T> {};
+
+template <class T>
+struct uncold<cold<T>> : is_type<T> {};
+
+template <class T>
+using uncold_t = is_type_t<uncold<T>>;
+
+template <class Key, class M>
+using record_element_t = uncold_t<map_element_t<Key, M>>;
+
+//==================================================================================================
+template <class Pair>
+using is_cold_pair = is_cold<second_t<Pair>>;
+
+template <class Pair>
+using is_hot_pair = std::integral_constant<bool, not is_cold<second_t<Pair>>::value>;
+
+template <class M>
+using map_cold = list_filter<is_cold_pair, M>;
+
+template <class M>
+using map_cold_t = is_type_t<map_cold<M>>;
+
+template <class M>
+using map_hot = list_filter<is_hot_pair, M>;
+
+template <class M>
+using map_hot_t = is_type_t<map_hot<M>>;
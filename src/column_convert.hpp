@@ -0,0 +1,199 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include "byte_order.hpp"
+#include "type_list.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+// Bulk conversion kernels over whole spans. The *_simd functions process a prefix of the span with
+// the instruction sets enabled at compile time and return its length, scalar loops finish.
+template <size_t size>
+size_t byteswap_simd(const unsigned char*, unsigned char*, size_t, index_constant<size>) {
+    return 0;
+}
+
+#if defined(__SSSE3__)
+// shuffle mask reversing each group of size bytes of a 16-byte lane
+template <size_t size>
+__m128i byteswap_mask() {
+    alignas(16) unsigned char mask[16];
+    for (size_t j = 0; j < 16; j++) {
+        mask[j] = static_cast<unsigned char>(j / size * size + size - 1 - j % size);
+    }
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+}
+
+template <size_t size>
+size_t byteswap_ssse3(const unsigned char* in, unsigned char* out, size_t n) {
+    const size_t bytes = n * size;
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i mask256 = _mm256_broadcastsi128_si256(byteswap_mask<size>());
+    for (; i + 32 <= bytes; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_shuffle_epi8(v, mask256));
+    }
+#endif
+    const __m128i mask = byteswap_mask<size>();
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_shuffle_epi8(v, mask));
+    }
+    return i / size;
+}
+
+inline size_t byteswap_simd(const unsigned char* in, unsigned char* out, size_t n,
+                            index_constant<2>) {
+    return byteswap_ssse3<2>(in, out, n);
+}
+
+inline size_t byteswap_simd(const unsigned char* in, unsigned char* out, size_t n,
+                            index_constant<4>) {
+    return byteswap_ssse3<4>(in, out, n);
+}
+
+inline size_t byteswap_simd(const unsigned char* in, unsigned char* out, size_t n,
+                            index_constant<8>) {
+    return byteswap_ssse3<8>(in, out, n);
+}
+#endif
+
+template <class T>
+void byteswap_span(const T* in, T* out, size_t n, std::true_type) {
+    size_t i = byteswap_simd(reinterpret_cast<const unsigned char*>(in),
+                             reinterpret_cast<unsigned char*>(out), n, index_constant<sizeof(T)>());
+    for (; i < n; i++) { out[i] = byteswap(in[i]); }
+}
+
+template <class T>
+void byteswap_span(const T* in, T* out, size_t n, std::false_type) {
+    if (in != out) { std::memmove(out, in, n * sizeof(T)); }
+}
+
+// out may be in, types without a byte order (see byteswap) are copied unchanged
+template <class T>
+void byteswap_span(const T* in, T* out, size_t n) {
+    static_assert(std::is_trivially_copyable<T>::value, "byteswap needs a trivially copyable type");
+    byteswap_span(in, out, n, has_byte_order<T>());
+}
+
+//==================================================================================================
+template <class From, class To>
+size_t convert_simd(const From*, To*, size_t) {
+    return 0;
+}
+
+#if defined(__SSE2__)
+inline size_t convert_simd(const float* in, double* out, size_t n) {
+    size_t i = 0;
+#if defined(__AVX__)
+    for (; i + 4 <= n; i += 4) { _mm256_storeu_pd(out + i, _mm256_cvtps_pd(_mm_loadu_ps(in + i))); }
+#endif
+    for (; i + 2 <= n; i += 2) {
+        __m128 v = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(in + i)));
+        _mm_storeu_pd(out + i, _mm_cvtps_pd(v));
+    }
+    return i;
+}
+
+inline size_t convert_simd(const double* in, float* out, size_t n) {
+    size_t i = 0;
+#if defined(__AVX__)
+    for (; i + 4 <= n; i += 4) { _mm_storeu_ps(out + i, _mm256_cvtpd_ps(_mm256_loadu_pd(in + i))); }
+#endif
+    for (; i + 2 <= n; i += 2) {
+        __m128 v = _mm_cvtpd_ps(_mm_loadu_pd(in + i));
+        _mm_store_sd(reinterpret_cast<double*>(out + i), _mm_castps_pd(v));
+    }
+    return i;
+}
+#endif
+
+#if defined(__SSE4_1__)
+inline size_t convert_simd(const int32_t* in, int64_t* out, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_cvtepi32_epi64(v));
+    }
+#endif
+    for (; i + 2 <= n; i += 2) {
+        __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_cvtepi32_epi64(v));
+    }
+    return i;
+}
+#endif
+
+// static_cast of each element: integer widening and narrowing, float <-> double...
+template <class From, class To>
+void convert_span(const From* in, To* out, size_t n) {
+    size_t i = convert_simd(in, out, n);
+    for (; i < n; i++) { out[i] = static_cast<To>(in[i]); }
+}
+
+//==================================================================================================
+// Loads n values of type From stored every stride bytes with the given byte order (a column, or a
+// field of consecutive records) and converts them to To.
+template <class From, class To>
+void load_column(const void* data, size_t n, To* out, byte_order order = byte_order::native,
+                 size_t stride = sizeof(From)) {
+    auto bytes = static_cast<const unsigned char*>(data);
+    if (std::is_same<From, To>::value and order == byte_order::native and stride == sizeof(From)) {
+        std::memcpy(out, bytes, n * sizeof(From));
+        return;
+    }
+    From buffer[256];
+    for (size_t first = 0; first < n; first += 256) {
+        size_t count = n - first < 256 ? n - first : 256;
+        if (stride == sizeof(From)) {
+            std::memcpy(buffer, bytes + first * stride, count * sizeof(From));
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                std::memcpy(buffer + i, bytes + (first + i) * stride, sizeof(From));
+            }
+        }
+        if (order != byte_order::native) { byteswap_span(buffer, buffer, count); }
+        convert_span(buffer, out + first, count);
+    }
+}
@@ -0,0 +1,256 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "column_convert.hpp"
+#include "fingerprint.hpp"
+#include "soa_vector.hpp"
+
+// File layout: columnar_header, one uint64_t file offset per column, then the columns in map order,
+// each starting at a multiple of columnar_alignment. Reading needs POSIX mmap.
+struct columnar_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t order;  // byte_order of the writer
+    uint64_t fingerprint;
+    uint64_t rows;
+    uint64_t columns;
+};
+
+constexpr char columnar_magic[8] = {'M', 'I', 'N', 'I', 'C', 'O', 'L', '\0'};
+constexpr uint32_t columnar_version = 1;
+constexpr size_t columnar_alignment = 64;
+
+inline columnar_header byteswap(columnar_header header) {
+    header.version = byteswap(header.version);
+    header.order = byteswap(header.order);
+    header.fingerprint = byteswap(header.fingerprint);
+    header.rows = byteswap(header.rows);
+    header.columns = byteswap(header.columns);
+    return header;
+}
+
+// file offset of each column given the number of rows and the value sizes
+template <size_t n>
+std::array<uint64_t, n> columnar_offsets(size_t rows, const std::array<size_t, n>& sizes) {
+    std::array<uint64_t, n> offsets;
+    uint64_t offset = sizeof(columnar_header) + n * sizeof(uint64_t);
+    for (size_t i = 0; i < n; i++) {
+        offsets[i] = round_up(offset, columnar_alignment);
+        offset = offsets[i] + rows * sizes[i];
+    }
+    return offsets;
+}
+
+// writes zeros up to offset then the n values of a column in the given byte order
+template <class T>
+bool write_columnar_column(std::FILE* file, uint64_t& position, uint64_t offset, const T* data,
+                           size_t n, byte_order order) {
+    const char zeros[columnar_alignment] = {};
+    bool ok = std::fwrite(zeros, 1, offset - position, file) == offset - position;
+    T buffer[256];
+    for (size_t first = 0; ok and first < n; first += 256) {
+        size_t count = n - first < 256 ? n - first : 256;
+        const T* chunk = data + first;
+        if (order != byte_order::native) {
+            byteswap_span(chunk, buffer, count);
+            chunk = buffer;
+        }
+        ok = std::fwrite(chunk, sizeof(T), count, file) == count;
+    }
+    position = offset + n * sizeof(T);
+    return ok;
+}
+
+//==================================================================================================
+template <class... Keys, class... Values>
+void write_columnar(const std::string& path,
+                    const soa_vector<type_map<type_pair<Keys, Values>...>>& vector,
+                    byte_order order = byte_order::native) {
+    using map = type_map<type_pair<Keys, Values>...>;
+    static_assert(list_and<std::is_trivially_copyable, type_list<uncold_t<Values>...>>::value,
+                  "columnar files only store trivially copyable values");
+
+    columnar_header header;
+    std::memcpy(header.magic, columnar_magic, sizeof(columnar_magic));
+    header.version = columnar_version;
+    header.order = uint32_t(order);
+    header.fingerprint = map_fingerprint<map>::value;
+    header.rows = vector.size();
+    header.columns = sizeof...(Values);
+    std::array<uint64_t, sizeof...(Values)> offsets = columnar_offsets(
+        vector.size(), std::array<size_t, sizeof...(Values)>{{sizeof(uncold_t<Values>)...}});
+    uint64_t position = sizeof(header) + sizeof...(Values) * sizeof(uint64_t);
+    if (order != byte_order::native) {
+        header = byteswap(header);
+        byteswap_span(offsets.data(), offsets.data(), offsets.size());
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) { throw std::runtime_error("cannot open " + path + " for writing"); }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 and
+              std::fwrite(offsets.data(), sizeof(uint64_t), sizeof...(Values), file) ==
+                  sizeof...(Values);
+    if (order != byte_order::native) {
+        byteswap_span(offsets.data(), offsets.data(), offsets.size());
+    }
+    bool written[] = {ok, (ok = ok and write_columnar_column(
+                                           file, position,
+                                           offsets[map_element_index<Keys, map>::value],
+                                           vector.template column<Keys>().data(),
+                                           vector.size(), order))...};
+    (void)written;
+    ok = std::fclose(file) == 0 and ok;
+    if (not ok) { throw std::runtime_error("cannot write " + path); }
+}
+
+//==================================================================================================
+// Read-only memory mapping of a file written by write_columnar, columns are spans into the mapping.
+// Files written in the other byte order are read with read_column, which converts them.
+template <class M>
+class columnar_file;
+
+template <class... Keys, class... Values>
+class columnar_file<type_map<type_pair<Keys, Values>...>> {
+    const unsigned char* data_{nullptr};
+    size_t file_size_{0};
+    size_t rows_{0};
+    byte_order order_{byte_order::native};
+    std::array<uint64_t, sizeof...(Values)> offsets_;
+
+    void unmap() {
+        if (data_ != nullptr) { munmap(const_cast<unsigned char*>(data_), file_size_); }
+        data_ = nullptr;
+    }
+
+    void check(bool condition, const std::string& path, const char* message) {
+        if (not condition) {
+            unmap();
+            throw std::runtime_error(path + ": " + message);
+        }
+    }
+
+  public:
+    using map = type_map<type_pair<Keys, Values>...>;
+
+    explicit columnar_file(const std::string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) { throw std::runtime_error("cannot open " + path); }
+        struct stat st;
+        void* mapping = MAP_FAILED;
+        if (fstat(fd, &st) == 0 and st.st_size > 0) {
+            file_size_ = size_t(st.st_size);
+            mapping = mmap(nullptr, file_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+        if (mapping == MAP_FAILED) { throw std::runtime_error("cannot map " + path); }
+        data_ = static_cast<const unsigned char*>(mapping);
+
+        const size_t table_size = sizeof...(Values) * sizeof(uint64_t);
+        check(file_size_ >= sizeof(columnar_header) + table_size, path, "file too small");
+        columnar_header header;
+        std::memcpy(&header, data_, sizeof(header));
+        check(std::memcmp(header.magic, columnar_magic, sizeof(columnar_magic)) == 0, path,
+              "not a columnar file");
+        if (header.order != uint32_t(byte_order::native)) {
+            order_ = byte_order::native == byte_order::little ? byte_order::big
+                                                              : byte_order::little;
+            header = byteswap(header);
+        }
+        check(header.version == columnar_version, path, "unsupported version");
+        check(header.order == uint32_t(order_), path, "invalid byte order");
+        check(header.fingerprint == map_fingerprint<map>::value and
+                  header.columns == sizeof...(Values),
+              path, "schema mismatch");
+        rows_ = header.rows;
+        std::memcpy(offsets_.data(), data_ + sizeof(header), table_size);
+        if (order_ != byte_order::native) {
+            byteswap_span(offsets_.data(), offsets_.data(), offsets_.size());
+        }
+        size_t sizes[] = {0, sizeof(uncold_t<Values>)...};
+        for (size_t i = 0; i < sizeof...(Values); i++) {
+            check(offsets_[i] % columnar_alignment == 0 and offsets_[i] <= file_size_ and
+                      rows_ <= (file_size_ - offsets_[i]) / sizes[i + 1],
+                  path, "truncated column");
+        }
+    }
+
+    columnar_file(columnar_file&& other) noexcept
+        : data_(other.data_),
+          file_size_(other.file_size_),
+          rows_(other.rows_),
+          order_(other.order_),
+          offsets_(other.offsets_) {
+        other.data_ = nullptr;
+    }
+
+    columnar_file(const columnar_file&) = delete;
+    columnar_file& operator=(const columnar_file&) = delete;
+
+    ~columnar_file() { unmap(); }
+
+    size_t size() const { return rows_; }
+    bool empty() const { return rows_ == 0; }
+    byte_order order() const { return order_; }
+
+    template <class Key>
+    column_span<const record_element_t<Key, map>> column() const {
+        constexpr size_t i = map_element_index<Key, map>::value;
+        if (order_ != byte_order::native) {
+            throw std::runtime_error("byte-swapped columns must be read with read_column");
+        }
+        return {reinterpret_cast<const record_element_t<Key, map>*>(data_ + offsets_[i]), rows_};
+    }
+
+    template <class Key>
+    const record_element_t<Key, map>& get(size_t i) const {
+        return column<Key>()[i];
+    }
+
+    // copies n values of column Key from row first into out, byte-swapped and converted to To
+    template <class Key, class To>
+    void read_column(To* out, size_t first, size_t n) const {
+        constexpr size_t i = map_element_index<Key, map>::value;
+        using T = record_element_t<Key, map>;
+        assert(first + n <= rows_);
+        load_column<T>(data_ + offsets_[i] + first * sizeof(T), n, out, order_);
+    }
+
+    template <class Key, class To>
+    void read_column(To* out) const {
+        read_column<Key>(out, 0, rows_);
+    }
+};
@@ -0,0 +1,109 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <utility>
+#include "record_storage.hpp"
+
+template <class T>
+using alignment_of = std::integral_constant<size_t, alignof(T)>;
+
+//==================================================================================================
+// Physical order of the elements of a list sorted by descending alignment (stable), which
+// minimizes padding. position(i) is the physical slot of logical element i, element(p) is the
+// logical index of the element stored in physical slot p.
+template <class L>
+struct alignment_order;
+
+template <class... Ts>
+struct alignment_order<type_list<Ts...>> {
+    static constexpr size_t size = sizeof...(Ts);
+
+    static constexpr size_t position(size_t i) {
+        const auto& a = list_map_to_value<alignment_of, size_t, type_list<Ts...>>::value;
+        size_t result = 0;
+        for (size_t j = 0; j < size; j++) {
+            if (a[j] > a[i] or (a[j] == a[i] and j < i)) { result++; }
+        }
+        return result;
+    }
+
+    static constexpr size_t element(size_t p) {
+        size_t result = size;
+        for (size_t i = 0; i < size; i++) {
+            if (position(i) == p) { result = i; }
+        }
+        return result;
+    }
+};
+
+//==================================================================================================
+template <class L, class Seq = std::make_index_sequence<list_size<L>::value>>
+struct compact_list;
+
+template <class L>
+using compact_list_t = is_type_t<compact_list<L>>;
+
+template <class L, size_t... Ps>
+struct compact_list<L, std::index_sequence<Ps...>>
+    : is_type<type_list<list_element_t<alignment_order<L>::element(Ps), L>...>> {};
+
+//==================================================================================================
+template <class L>
+struct compact_tuple;
+
+template <>
+struct compact_tuple<type_list<>> {
+    using list = type_list<>;
+    record_storage<> data;
+};
+
+template <class... Ts>
+struct compact_tuple<type_list<Ts...>> {
+    using list = type_list<Ts...>;
+    using order = alignment_order<list>;
+    list_record_storage_t<compact_list_t<list>> data;
+
+    compact_tuple() = default;
+    constexpr compact_tuple(const Ts&... values)
+        : compact_tuple(std::make_index_sequence<sizeof...(Ts)>(), std::tie(values...)) {}
+
+  private:
+    template <size_t... Ps>
+    constexpr compact_tuple(std::index_sequence<Ps...>, const std::tuple<const Ts&...>& values)
+        : data(std::get<order::element(Ps)>(values)...) {}
+};
+
+template <size_t i, class L>
+constexpr auto& get(compact_tuple<L>& t) {
+    return get<compact_tuple<L>::order::position(i)>(t.data);
+}
+
+template <size_t i, class L>
+constexpr auto& get(const compact_tuple<L>& t) {
+    return get<compact_tuple<L>::order::position(i)>(t.data);
+}
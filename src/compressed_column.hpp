@@ -0,0 +1,338 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include "aligned_vector.hpp"
+#include "cold.hpp"
+
+// Codecs of integer columns, to be used as map values: type_pair<Key, delta<int64_t>>.
+template <class T>
+struct delta {};  // zigzag-encoded differences with the previous value, bit-packed per block
+
+template <class T, size_t Bits>
+struct bitpacked {};  // values in [0, 2^Bits) stored on Bits bits, other values are truncated
+
+template <class T>
+struct frame_of_reference {};  // differences with the block minimum, bit-packed per block
+
+template <class V>
+struct codec_value : is_type<uncold_t<V>> {};
+
+template <class T>
+struct codec_value<delta<T>> : is_type<T> {};
+
+template <class T, size_t Bits>
+struct codec_value<bitpacked<T, Bits>> : is_type<T> {};
+
+template <class T>
+struct codec_value<frame_of_reference<T>> : is_type<T> {};
+
+template <class V>
+using codec_value_t = is_type_t<codec_value<V>>;
+
+constexpr size_t codec_block_size = 256;
+
+//==================================================================================================
+inline size_t bit_width_of(uint64_t max) {
+    size_t bits = 0;
+    while (bits < 64 and (max >> bits) != 0) { bits++; }
+    return bits;
+}
+
+inline size_t packed_words(size_t n, size_t bits) { return n * bits / 64 + 2; }
+
+// Branch-free bit packing: the bits of a value that spill into the next word are moved with two
+// shifts, which give 0 instead of overflowing when nothing spills, hence the word of slack.
+inline void pack_bits(const uint64_t* values, size_t n, size_t bits, uint64_t* words) {
+    for (size_t i = 0; i < packed_words(n, bits); i++) { words[i] = 0; }
+    for (size_t i = 0; i < n; i++) {
+        size_t bit = i * bits, word = bit / 64, shift = bit % 64;
+        words[word] |= values[i] << shift;
+        words[word + 1] |= (values[i] >> 1) >> (63 - shift);
+    }
+}
+
+inline void unpack_bits(const uint64_t* words, size_t n, size_t bits, uint64_t* values) {
+    const uint64_t mask = bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+    for (size_t i = 0; i < n; i++) {
+        size_t bit = i * bits, word = bit / 64, shift = bit % 64;
+        values[i] = ((words[word] >> shift) | ((words[word + 1] << 1) << (63 - shift))) & mask;
+    }
+}
+
+//==================================================================================================
+// Transforms between a block of values and unsigned integers to bit-pack, relative to a per-block
+// reference value. These are simple loops over whole blocks that compilers vectorize, except the
+// prefix sum of delta.
+template <class Codec>
+struct column_codec;
+
+template <class T>
+struct column_codec<delta<T>> {
+    static_assert(std::is_integral<T>::value, "delta needs an integer type");
+
+    static uint64_t encode(const T* values, size_t n, uint64_t* out) {
+        uint64_t previous = uint64_t(values[0]);
+        for (size_t i = 0; i < n; i++) {
+            auto d = int64_t(uint64_t(values[i]) - previous);
+            out[i] = (uint64_t(d) << 1) ^ uint64_t(d >> 63);
+            previous = uint64_t(values[i]);
+        }
+        return uint64_t(values[0]);
+    }
+
+    static void decode(const uint64_t* in, size_t n, uint64_t reference, T* values) {
+        for (size_t i = 0; i < n; i++) {
+            reference += (in[i] >> 1) ^ (0 - (in[i] & 1));
+            values[i] = T(reference);
+        }
+    }
+};
+
+template <class T>
+struct column_codec<frame_of_reference<T>> {
+    static_assert(std::is_integral<T>::value, "frame_of_reference needs an integer type");
+
+    static uint64_t encode(const T* values, size_t n, uint64_t* out) {
+        T min = values[0];
+        for (size_t i = 0; i < n; i++) { min = values[i] < min ? values[i] : min; }
+        for (size_t i = 0; i < n; i++) { out[i] = uint64_t(values[i]) - uint64_t(min); }
+        return uint64_t(min);
+    }
+
+    static void decode(const uint64_t* in, size_t n, uint64_t reference, T* values) {
+        for (size_t i = 0; i < n; i++) { values[i] = T(reference + in[i]); }
+    }
+};
+
+template <class T, size_t Bits>
+struct column_codec<bitpacked<T, Bits>> {
+    static_assert(std::is_integral<T>::value and Bits <= 64, "invalid bitpacked column");
+
+    // values are masked so that out of range ones cannot spill into their neighbours
+    static uint64_t encode(const T* values, size_t n, uint64_t* out) {
+        const uint64_t mask = Bits == 64 ? ~uint64_t(0) : (uint64_t(1) << (Bits % 64)) - 1;
+        for (size_t i = 0; i < n; i++) { out[i] = uint64_t(values[i]) & mask; }
+        return 0;
+    }
+
+    static void decode(const uint64_t* in, size_t n, uint64_t, T* values) {
+        for (size_t i = 0; i < n; i++) { values[i] = T(in[i]); }
+    }
+};
+
+template <class Codec>
+struct codec_bits : index_constant<0> {};  // 0 means computed per block
+
+template <class T, size_t Bits>
+struct codec_bits<bitpacked<T, Bits>> : index_constant<Bits> {};
+
+//==================================================================================================
+// Column of values encoded by blocks of codec_block_size. The last incomplete block is kept
+// decoded until it is full. Scans decode one block at a time with for_each_block.
+template <class Codec>
+class compressed_column {
+    struct block {
+        uint64_t reference;
+        size_t bits;
+        size_t first_word;
+    };
+
+    std::vector<block> blocks_;
+    std::vector<uint64_t> words_;
+    std::vector<codec_value_t<Codec>> tail_;
+
+    void encode_tail() {
+        uint64_t values[codec_block_size];
+        block b;
+        b.reference = column_codec<Codec>::encode(tail_.data(), tail_.size(), values);
+        uint64_t max = 0;
+        for (size_t i = 0; i < tail_.size(); i++) { max = values[i] > max ? values[i] : max; }
+        b.bits = codec_bits<Codec>::value != 0 ? codec_bits<Codec>::value : bit_width_of(max);
+        b.first_word = words_.size();
+        words_.resize(words_.size() + packed_words(tail_.size(), b.bits));
+        pack_bits(values, tail_.size(), b.bits, words_.data() + b.first_word);
+        blocks_.push_back(b);
+        tail_.clear();
+    }
+
+  public:
+    using value_type = codec_value_t<Codec>;
+    static constexpr size_t block_size = codec_block_size;
+
+    size_t size() const { return blocks_.size() * block_size + tail_.size(); }
+    bool empty() const { return size() == 0; }
+    size_t block_count() const { return blocks_.size() + (tail_.empty() ? 0 : 1); }
+
+    // bytes used by the encoded blocks and the decoded tail
+    size_t memory_usage() const {
+        return blocks_.size() * sizeof(block) + words_.size() * sizeof(uint64_t) +
+               tail_.size() * sizeof(value_type);
+    }
+
+    void push_back(value_type value) {
+        tail_.push_back(value);
+        if (tail_.size() == block_size) { encode_tail(); }
+    }
+
+    void clear() {
+        blocks_.clear();
+        words_.clear();
+        tail_.clear();
+    }
+
+    // decodes block i into out, which has room for block_size values, returns its size
+    size_t decode_block(size_t i, value_type* out) const {
+        if (i == blocks_.size()) {
+            std::copy(tail_.begin(), tail_.end(), out);
+            return tail_.size();
+        }
+        uint64_t values[codec_block_size];
+        const block& b = blocks_[i];
+        unpack_bits(words_.data() + b.first_word, block_size, b.bits, values);
+        column_codec<Codec>::decode(values, block_size, b.reference, out);
+        return block_size;
+    }
+
+    // calls f(const value_type* values, size_t n) on each decoded block
+    template <class F>
+    void for_each_block(F&& f) const {
+        value_type values[codec_block_size];
+        for (size_t i = 0; i < block_count(); i++) { f(values, decode_block(i, values)); }
+    }
+
+    // random access decodes the whole block of the value
+    value_type get(size_t i) const {
+        if (i >= blocks_.size() * block_size) { return tail_[i - blocks_.size() * block_size]; }
+        value_type values[codec_block_size];
+        decode_block(i / block_size, values);
+        return values[i % block_size];
+    }
+};
+
+template <class Codec>
+constexpr size_t compressed_column<Codec>::block_size;
+
+// Uncompressed column with the same interface, blocks are read in place.
+template <class T>
+class plain_column {
+    aligned_vector<T> values_;
+
+  public:
+    using value_type = T;
+    static constexpr size_t block_size = codec_block_size;
+
+    size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+    size_t block_count() const { return (values_.size() + block_size - 1) / block_size; }
+    size_t memory_usage() const { return values_.size() * sizeof(T); }
+    void push_back(const T& value) { values_.push_back(value); }
+    void clear() { values_.clear(); }
+
+    size_t decode_block(size_t i, T* out) const {
+        size_t n = std::min(block_size, values_.size() - i * block_size);
+        std::copy(values_.begin() + i * block_size, values_.begin() + i * block_size + n, out);
+        return n;
+    }
+
+    template <class F>
+    void for_each_block(F&& f) const {
+        for (size_t i = 0; i < values_.size(); i += block_size) {
+            f(values_.data() + i, std::min(block_size, values_.size() - i));
+        }
+    }
+
+    const T& get(size_t i) const { return values_[i]; }
+};
+
+template <class T>
+constexpr size_t plain_column<T>::block_size;
+
+template <class V>
+struct column_of : is_type<plain_column<codec_value_t<V>>> {};
+
+template <class T>
+struct column_of<delta<T>> : is_type<compressed_column<delta<T>>> {};
+
+template <class T, size_t Bits>
+struct column_of<bitpacked<T, Bits>> : is_type<compressed_column<bitpacked<T, Bits>>> {};
+
+template <class T>
+struct column_of<frame_of_reference<T>> : is_type<compressed_column<frame_of_reference<T>>> {};
+
+template <class V>
+using column_of_t = is_type_t<column_of<V>>;
+
+//==================================================================================================
+// Struct of arrays whose columns are compressed according to the codecs of the map values.
+template <class M>
+class compressed_vector;
+
+template <class... Keys, class... Values>
+class compressed_vector<type_map<type_pair<Keys, Values>...>> {
+    std::tuple<column_of_t<Values>...> columns;
+    size_t size_{0};
+
+    template <size_t... Is>
+    size_t memory_usage(std::index_sequence<Is...>) const {
+        size_t usages[] = {0, std::get<Is>(columns).memory_usage()...};
+        size_t result = 0;
+        for (size_t usage : usages) { result += usage; }
+        return result;
+    }
+
+    template <size_t... Is>
+    void push_back(std::index_sequence<Is...>, const codec_value_t<Values>&... values) {
+        int dummy[] = {0, (std::get<Is>(columns).push_back(values), 0)...};
+        (void)dummy;
+        size_++;
+    }
+
+  public:
+    using map = type_map<type_pair<Keys, Values>...>;
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    size_t memory_usage() const { return memory_usage(std::index_sequence_for<Values...>()); }
+
+    void push_back(const codec_value_t<Values>&... values) {
+        push_back(std::index_sequence_for<Values...>(), values...);
+    }
+
+    template <class Key>
+    const auto& column() const {
+        return std::get<map_element_index<Key, map>::value>(columns);
+    }
+
+    template <class Key>
+    codec_value_t<map_element_t<Key, map>> get(size_t i) const {
+        return column<Key>().get(i);
+    }
+};
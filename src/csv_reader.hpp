@@ -0,0 +1,260 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "soa_vector.hpp"
+#include "type_id.hpp"
+
+// Parses the characters in [begin, end) into out, returns false if they are not a valid T (integers
+// out of the range of T included). Specialize for other field types (for instance enums spelled by
+// name).
+template <class T, class Enable = void>
+struct field_parser;
+
+template <class T>
+struct field_parser<T, std::enable_if_t<std::is_integral<T>::value and
+                                        not std::is_same<T, bool>::value>> {
+    static bool parse(const char* begin, const char* end, T& out) {
+        bool negative = begin != end and *begin == '-';
+        if (begin != end and (*begin == '-' or *begin == '+')) { begin++; }
+        if (begin == end or (negative and std::is_unsigned<T>::value)) { return false; }
+        using unsigned_t = std::make_unsigned_t<T>;
+        const uint64_t limit = uint64_t(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+        const uint64_t limit_tens = limit / 10, limit_units = limit % 10;
+        uint64_t value = 0;
+        for (; begin != end; begin++) {
+            uint64_t digit = uint64_t(unsigned(*begin) - unsigned('0'));
+            if (digit > 9 or value > limit_tens or (value == limit_tens and digit > limit_units)) {
+                return false;
+            }
+            value = value * 10 + digit;
+        }
+        out = negative ? T(unsigned_t(0) - unsigned_t(value)) : T(value);
+        return true;
+    }
+};
+
+// Plain decimals with at most 15 significant digits and 22 decimals are exact quotients of two
+// exactly representable doubles (Clinger's fast path), others go through strtod.
+inline bool parse_simple_decimal(const char* begin, const char* end, double& out) {
+    static constexpr double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                        1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                        1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    bool negative = *begin == '-';
+    if (*begin == '-' or *begin == '+') { begin++; }
+    uint64_t mantissa = 0;
+    size_t digits = 0, decimals = 0;
+    bool dot = false;
+    for (; begin != end; begin++) {
+        if (*begin == '.' and not dot) {
+            dot = true;
+            continue;
+        }
+        unsigned digit = unsigned(*begin) - unsigned('0');
+        if (digit > 9 or ++digits > 15) { return false; }
+        mantissa = mantissa * 10 + digit;
+        decimals += dot ? 1 : 0;
+    }
+    if (digits == 0 or decimals > 22) { return false; }
+    double value = double(mantissa) / powers[decimals];
+    out = negative ? -value : value;
+    return true;
+}
+
+template <class T>
+struct field_parser<T, std::enable_if_t<std::is_floating_point<T>::value>> {
+    static bool parse(const char* begin, const char* end, T& out) {
+        double simple;
+        if (begin != end and parse_simple_decimal(begin, end, simple)) {
+            out = T(simple);
+            return true;
+        }
+        char buffer[64];  // strtod needs a null-terminated string
+        size_t size = size_t(end - begin);
+        if (size == 0 or size >= sizeof(buffer)) { return false; }
+        std::memcpy(buffer, begin, size);
+        buffer[size] = '\0';
+        char* parsed;
+        out = T(std::strtod(buffer, &parsed));
+        return parsed == buffer + size;
+    }
+};
+
+template <>
+struct field_parser<bool> {
+    static bool parse(const char* begin, const char* end, bool& out) {
+        const_string s(begin, size_t(end - begin));
+        out = s == "1" or s == "true";
+        return out or s == "0" or s == "false";
+    }
+};
+
+// enums are read as their underlying integer unless field_parser is specialized for them
+template <class T>
+struct field_parser<T, std::enable_if_t<std::is_enum<T>::value>> {
+    static bool parse(const char* begin, const char* end, T& out) {
+        std::underlying_type_t<T> value;
+        if (not field_parser<std::underlying_type_t<T>>::parse(begin, end, value)) { return false; }
+        out = T(value);
+        return true;
+    }
+};
+
+// fixed-size strings, truncated and zero-padded
+template <size_t n>
+struct field_parser<std::array<char, n>> {
+    static bool parse(const char* begin, const char* end, std::array<char, n>& out) {
+        size_t size = size_t(end - begin) < n ? size_t(end - begin) : n;
+        std::memcpy(out.data(), begin, size);
+        std::memset(out.data() + size, 0, n - size);
+        return true;
+    }
+};
+
+//==================================================================================================
+struct csv_options {
+    char delimiter;
+    bool header;  // skip the first line
+
+    csv_options(char delimiter = ',', bool header = false)
+        : delimiter(delimiter), header(header) {}
+};
+
+// One record per line and one field per column of M, in map order. Quoting is not supported.
+template <class M>
+class csv_reader;
+
+template <class... Keys, class... Values>
+class csv_reader<type_map<type_pair<Keys, Values>...>> {
+    static constexpr size_t n = sizeof...(Values);
+    using vector = soa_vector<type_map<type_pair<Keys, Values>...>>;
+
+    csv_options options_;
+    size_t line_{0};
+    std::vector<char> buffer_;
+
+    [[noreturn]] void fail(const char* message) const {
+        throw std::runtime_error("csv line " + std::to_string(line_) + ": " + message);
+    }
+
+    template <size_t... Is>
+    void parse_fields(const char* const* begins, const char* const* ends, vector& out, size_t row,
+                      std::index_sequence<Is...>) const {
+        bool ok[] = {true, field_parser<uncold_t<Values>>::parse(begins[Is], ends[Is],
+                                                                 out.template get<Keys>(row))...};
+        for (bool field_ok : ok) {
+            if (not field_ok) { fail("invalid field"); }
+        }
+    }
+
+    void parse_line(const char* begin, const char* end, vector& out, size_t row) const {
+        const char* begins[n + 1];
+        const char* ends[n + 1];
+        for (size_t i = 0; i < n; i++) {
+            auto delimiter = static_cast<const char*>(
+                std::memchr(begin, options_.delimiter, size_t(end - begin)));
+            bool last = i + 1 == n;
+            if (last != (delimiter == nullptr)) {
+                fail(last ? "too many fields" : "not enough fields");
+            }
+            begins[i] = begin;
+            ends[i] = last ? end : delimiter;
+            begin = ends[i] + 1;
+        }
+        parse_fields(begins, ends, out, row, std::index_sequence_for<Values...>());
+    }
+
+  public:
+    using map = type_map<type_pair<Keys, Values>...>;
+
+    explicit csv_reader(csv_options options = csv_options()) : options_(options) {}
+
+    // Appends the records of the lines in [begin, end) to out and returns their number. Lines are
+    // counted first so that columns are grown once per block, then parsed in place. If a line is
+    // invalid, out keeps the records of the lines before it.
+    size_t parse(const char* begin, const char* end, vector& out) {
+        size_t rows = 0;
+        for (const char* p = begin; p < end; rows++) {
+            auto newline = static_cast<const char*>(std::memchr(p, '\n', size_t(end - p)));
+            p = newline == nullptr ? end : newline + 1;
+        }
+        const size_t first_row = out.size();
+        size_t row = first_row;
+        out.resize(first_row + rows);
+        while (begin < end) {
+            auto newline = static_cast<const char*>(std::memchr(begin, '\n', size_t(end - begin)));
+            const char* line_end = newline == nullptr ? end : newline;
+            const char* next = newline == nullptr ? end : newline + 1;
+            if (line_end != begin and line_end[-1] == '\r') { line_end--; }
+            bool skipped = ++line_ == 1 and options_.header;
+            if (not skipped and line_end != begin) {
+                try {
+                    parse_line(begin, line_end, out, row);
+                } catch (...) {
+                    out.resize(row);  // only keeps the lines parsed before the failing one
+                    throw;
+                }
+                row++;
+            }
+            begin = next;
+        }
+        out.resize(row);  // minus empty and header lines
+        return row - first_row;
+    }
+
+    // Reads the whole stream block by block, returns the number of records appended to out.
+    size_t read(std::istream& in, vector& out, size_t block_size = size_t(1) << 20) {
+        size_t records = 0;
+        size_t pending = 0;  // bytes of an incomplete line kept from the previous block
+        buffer_.resize(block_size);
+        while (in) {
+            if (pending == buffer_.size()) { buffer_.resize(2 * buffer_.size()); }
+            in.read(buffer_.data() + pending, std::streamsize(buffer_.size() - pending));
+            size_t size = pending + size_t(in.gcount());
+            size_t complete = size;
+            if (in) {
+                while (complete > 0 and buffer_[complete - 1] != '\n') { complete--; }
+            }
+            records += parse(buffer_.data(), buffer_.data() + complete, out);
+            pending = size - complete;
+            std::memmove(buffer_.data(), buffer_.data() + complete, pending);
+        }
+        return records;
+    }
+};
+
+template <class M>
+size_t read_csv(std::istream& in, soa_vector<M>& out, csv_options options = csv_options()) {
+    return csv_reader<M>(options).read(in, out);
+}
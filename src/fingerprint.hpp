@@ -0,0 +1,73 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include "cold.hpp"
+#include "layout.hpp"
+#include "type_id.hpp"
+#include "type_map.hpp"
+
+constexpr uint64_t fingerprint_basis = 14695981039346656037ull;
+
+// fnv1a over the 8 bytes of a word, independent of the host byte order
+constexpr uint64_t fingerprint_combine(uint64_t hash, uint64_t word) {
+    for (int i = 0; i < 8; i++) { hash = (hash ^ ((word >> (8 * i)) & 0xff)) * 1099511628211ull; }
+    return hash;
+}
+
+template <size_t n>
+constexpr uint64_t fingerprint_fields(uint64_t hash, const std::array<uint64_t, n>& ids,
+                                      const std::array<size_t, n>& sizes,
+                                      const std::array<size_t, n>& alignments) {
+    hash = fingerprint_combine(hash, n);
+    for (size_t i = 0; i < n; i++) {
+        hash = fingerprint_combine(hash, ids[i]);
+        hash = fingerprint_combine(hash, sizes[i]);
+        hash = fingerprint_combine(hash, alignments[i]);
+    }
+    return hash;
+}
+
+template <size_t n>
+constexpr uint64_t fingerprint_keys(uint64_t hash, const std::array<uint64_t, n>& ids) {
+    for (size_t i = 0; i < n; i++) { hash = fingerprint_combine(hash, ids[i]); }
+    return hash;
+}
+
+//==================================================================================================
+// 64-bit hash of the type ids, sizes and alignments of the elements of a list, in order
+template <class L>
+using list_fingerprint = std::integral_constant<
+    uint64_t, fingerprint_fields(fingerprint_basis, list_type_ids<L>::value,
+                                 list_layout<L>::sizes::value, list_layout<L>::alignments::value)>;
+
+// same for the stored values of a map (cold<T> is stored as T), combined with the type ids of its
+// keys
+template <class M>
+using map_fingerprint = std::integral_constant<
+    uint64_t, fingerprint_keys(list_fingerprint<list_map_t<uncold_t, map_value_list_t<M>>>::value,
+                               list_type_ids<map_key_list_t<M>>::value)>;
@@ -0,0 +1,113 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include "soa_vector.hpp"
+
+template <class M>
+class hot_cold_vector;
+
+template <class... Keys, class... Values>
+class hot_cold_vector<type_map<type_pair<Keys, Values>...>> {
+  public:
+    using map = type_map<type_pair<Keys, Values>...>;
+    using hot_record = typed_record<map_hot_t<map>>;
+    using cold_record = typed_record<map_cold_t<map>>;
+
+  private:
+    aligned_vector<hot_record> hot_;
+    aligned_vector<cold_record> cold_;
+
+    template <class... Ks, class... Vs, class Tuple>
+    static typed_record<type_map<type_pair<Ks, Vs>...>> split(
+        is_type<type_map<type_pair<Ks, Vs>...>>, const Tuple& values) {
+        return {std::get<map_element_index<Ks, map>::value>(values)...};
+    }
+
+    hot_record& part(size_t i, std::false_type) { return hot_[i]; }
+    const hot_record& part(size_t i, std::false_type) const { return hot_[i]; }
+    cold_record& part(size_t i, std::true_type) { return cold_[i]; }
+    const cold_record& part(size_t i, std::true_type) const { return cold_[i]; }
+
+  public:
+    size_t size() const { return hot_.size(); }
+    bool empty() const { return hot_.empty(); }
+
+    void reserve(size_t n) {
+        hot_.reserve(n);
+        cold_.reserve(n);
+    }
+
+    void resize(size_t n) {
+        size_t old_size = hot_.size();
+        hot_.resize(n);
+        try {
+            cold_.resize(n);
+        } catch (...) {
+            hot_.resize(old_size);
+            throw;
+        }
+    }
+
+    void clear() { resize(0); }
+
+    void push_back(const uncold_t<Values>&... values) {
+        auto all = std::tie(values...);
+        hot_record hot = split(map_hot<map>(), all);
+        cold_record cold = split(map_cold<map>(), all);
+        hot_.push_back(std::move(hot));
+        try {
+            cold_.push_back(std::move(cold));
+        } catch (...) {
+            hot_.pop_back();  // keeps hot and cold parts of the same size
+            throw;
+        }
+    }
+
+    template <class Layout>
+    void push_back(const typed_record<map, Layout>& record) {
+        push_back(record.template get<Keys>()...);
+    }
+
+    template <class Key>
+    record_element_t<Key, map>& get(size_t i) {
+        return part(i, is_cold<map_element_t<Key, map>>()).template get<Key>();
+    }
+
+    template <class Key>
+    const record_element_t<Key, map>& get(size_t i) const {
+        return part(i, is_cold<map_element_t<Key, map>>()).template get<Key>();
+    }
+
+    soa_row<hot_cold_vector> operator[](size_t i) { return {this, i}; }
+    soa_row<const hot_cold_vector> operator[](size_t i) const { return {this, i}; }
+
+    column_span<hot_record> hot_records() { return {hot_.data(), hot_.size()}; }
+    column_span<const hot_record> hot_records() const { return {hot_.data(), hot_.size()}; }
+    column_span<cold_record> cold_records() { return {cold_.data(), cold_.size()}; }
+    column_span<const cold_record> cold_records() const { return {cold_.data(), cold_.size()}; }
+};
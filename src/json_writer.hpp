@@ -0,0 +1,246 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "name_index.hpp"
+#include "soa_vector.hpp"
+#include "value_list.hpp"
+
+// '{"name":' for the first key of an object, ',"name":' for the others
+template <size_t n>
+constexpr value_array<char, n> json_key_fragment(const_string name, char prefix) {
+    value_array<char, n> result{};
+    result[0] = prefix;
+    result[1] = '"';
+    for (size_t i = 0; i < name.size(); i++) { result[i + 2] = name[i]; }
+    result[n - 2] = '"';
+    result[n - 1] = ':';
+    return result;
+}
+
+constexpr bool json_plain(const_string s) {
+    for (char c : s) {
+        if (c == '"' or c == '\\' or static_cast<unsigned char>(c) < 0x20) { return false; }
+    }
+    return true;
+}
+
+template <class Key, bool first>
+struct json_key {
+    static_assert(json_plain(tag_name<Key>::get()), "json keys are not escaped");
+    static constexpr size_t size = tag_name<Key>::get().size() + 4;
+    static constexpr value_array<char, size> value =
+        json_key_fragment<size>(tag_name<Key>::get(), first ? '{' : ',');
+};
+
+template <class Key, bool first>
+constexpr size_t json_key<Key, first>::size;
+
+template <class Key, bool first>
+constexpr value_array<char, json_key<Key, first>::size> json_key<Key, first>::value;
+
+//==================================================================================================
+// writes the decimal digits of v ending at end, returns their beginning
+inline char* format_decimal(uint64_t v, char* end) {
+    static const char pairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    while (v >= 100) {
+        end -= 2;
+        std::memcpy(end, pairs + 2 * (v % 100), 2);
+        v /= 100;
+    }
+    if (v >= 10) {
+        end -= 2;
+        std::memcpy(end, pairs + 2 * v, 2);
+    } else {
+        *--end = char('0' + v);
+    }
+    return end;
+}
+
+// Appends the JSON representation of a value to a string. Specialize for other value types.
+template <class T, class Enable = void>
+struct json_value;
+
+template <class T>
+struct json_value<T, std::enable_if_t<std::is_integral<T>::value and
+                                      not std::is_same<T, bool>::value>> {
+    static void append(std::string& out, T value) {
+        char buffer[24];
+        char* end = buffer + sizeof(buffer);
+        uint64_t magnitude = value < 0 ? 0 - uint64_t(value) : uint64_t(value);
+        char* begin = format_decimal(magnitude, end);
+        if (value < 0) { *--begin = '-'; }
+        out.append(begin, end);
+    }
+};
+
+// shortest round-trip formatting is not available before C++17, snprintf("%.17g") is used instead
+template <class T>
+struct json_value<T, std::enable_if_t<std::is_floating_point<T>::value>> {
+    static void append(std::string& out, T value) {
+        if (not std::isfinite(value)) {
+            out.append("null", 4);
+            return;
+        }
+        char buffer[32];
+        int size = std::snprintf(buffer, sizeof(buffer), "%.*g",
+                                 std::is_same<T, float>::value ? 9 : 17, double(value));
+        out.append(buffer, size_t(size));
+    }
+};
+
+template <>
+struct json_value<bool> {
+    static void append(std::string& out, bool value) {
+        value ? out.append("true", 4) : out.append("false", 5);
+    }
+};
+
+template <class T>
+struct json_value<T, std::enable_if_t<std::is_enum<T>::value>> {
+    static void append(std::string& out, T value) {
+        json_value<std::underlying_type_t<T>>::append(out, std::underlying_type_t<T>(value));
+    }
+};
+
+inline void append_json_string(std::string& out, const char* begin, const char* end) {
+    static const char hex[] = "0123456789abcdef";
+    out.push_back('"');
+    while (begin != end) {
+        const char* plain = begin;
+        while (plain != end and *plain != '"' and *plain != '\\' and
+               static_cast<unsigned char>(*plain) >= 0x20) {
+            plain++;
+        }
+        out.append(begin, plain);
+        if (plain == end) { break; }
+        char c = *plain;
+        char escape[6] = {'\\', c, 0, 0, 0, 0};
+        size_t size = 2;
+        if (c == '\n') {
+            escape[1] = 'n';
+        } else if (c == '\t') {
+            escape[1] = 't';
+        } else if (c == '\r') {
+            escape[1] = 'r';
+        } else if (c != '"' and c != '\\') {
+            const char unicode[6] = {'\\', 'u', '0', '0', hex[(c >> 4) & 0xf], hex[c & 0xf]};
+            std::memcpy(escape, unicode, sizeof(unicode));
+            size = 6;
+        }
+        out.append(escape, size);
+        begin = plain + 1;
+    }
+    out.push_back('"');
+}
+
+template <class Traits, class Alloc>
+struct json_value<std::basic_string<char, Traits, Alloc>> {
+    static void append(std::string& out, const std::basic_string<char, Traits, Alloc>& value) {
+        append_json_string(out, value.data(), value.data() + value.size());
+    }
+};
+
+template <>
+struct json_value<const_string> {
+    static void append(std::string& out, const_string value) {
+        append_json_string(out, value.begin(), value.end());
+    }
+};
+
+// fixed-size strings stop at their first null character
+template <size_t n>
+struct json_value<std::array<char, n>> {
+    static void append(std::string& out, const std::array<char, n>& value) {
+        size_t size = 0;
+        while (size < n and value[size] != '\0') { size++; }
+        append_json_string(out, value.data(), value.data() + size);
+    }
+};
+
+//==================================================================================================
+// Appends records of a type_map schema as JSON objects to a reusable buffer. Keys are written as
+// precomputed fragments, so a record costs one append per key plus its values.
+class json_writer {
+    std::string buffer_;
+
+    template <class Record, class Key, class... Keys>
+    void write_fields(const Record& record, type_list<Key, Keys...>) {
+        const auto& first = json_key<Key, true>::value;
+        buffer_.append(first.data, json_key<Key, true>::size);
+        json_value<std::decay_t<decltype(record.template get<Key>())>>::append(
+            buffer_, record.template get<Key>());
+        int dummy[] = {0, (write_field<Keys>(record), 0)...};
+        (void)dummy;
+        buffer_.push_back('}');
+    }
+
+    template <class Record>
+    void write_fields(const Record&, type_list<>) {
+        buffer_.append("{}", 2);
+    }
+
+    template <class Key, class Record>
+    void write_field(const Record& record) {
+        const auto& fragment = json_key<Key, false>::value;
+        buffer_.append(fragment.data, json_key<Key, false>::size);
+        json_value<std::decay_t<decltype(record.template get<Key>())>>::append(
+            buffer_, record.template get<Key>());
+    }
+
+  public:
+    const std::string& str() const { return buffer_; }
+    void clear() { buffer_.clear(); }  // keeps the capacity
+    void reserve(size_t n) { buffer_.reserve(n); }
+
+    // Record is anything with get<Key>() for the keys of M (typed_record, soa_row, record_view...)
+    template <class M, class Record>
+    void write(const Record& record) {
+        write_fields(record, map_key_list_t<M>());
+    }
+
+    template <class M, class Layout>
+    void write(const typed_record<M, Layout>& record) {
+        write_fields(record, map_key_list_t<M>());
+    }
+
+    // one object per line
+    template <class M>
+    void write_lines(const soa_vector<M>& vector) {
+        for (size_t i = 0; i < vector.size(); i++) {
+            write<M>(vector[i]);
+            buffer_.push_back('\n');
+        }
+    }
+};
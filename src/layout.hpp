@@ -0,0 +1,94 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include "compact_tuple.hpp"
+
+template <class T>
+using size_of = std::integral_constant<size_t, sizeof(T)>;
+
+//==================================================================================================
+template <class L>
+struct list_layout;
+
+template <class... Ts>
+struct list_layout<type_list<Ts...>> {
+    using sizes = list_map_to_value<size_of, size_t, type_list<Ts...>>;
+    using alignments = list_map_to_value<alignment_of, size_t, type_list<Ts...>>;
+
+    template <size_t... Is>
+    static constexpr std::array<size_t, sizeof...(Is)> make_offsets(std::index_sequence<Is...>) {
+        return {{layout_offset(sizes::value, alignments::value, Is)...}};
+    }
+};
+
+template <class L>
+struct list_offsets {
+    static constexpr std::array<size_t, list_size<L>::value> value =
+        list_layout<L>::make_offsets(std::make_index_sequence<list_size<L>::value>());
+};
+
+template <class L>
+constexpr std::array<size_t, list_size<L>::value> list_offsets<L>::value;
+
+template <class L>
+using list_layout_align =
+    index_constant<layout_alignment(list_layout<L>::alignments::value)>;
+
+template <class L>
+using list_layout_size = index_constant<round_up(
+    layout_offset(list_layout<L>::sizes::value, list_layout<L>::alignments::value,
+                  list_size<L>::value),
+    list_layout_align<L>::value)>;
+
+template <class L>
+using list_layout_padding = index_constant<
+    list_layout_size<L>::value -
+    list_reduce_to_value<size_of, std::plus<size_t>, size_t, 0, L>::value>;
+
+//==================================================================================================
+// Same layout with elements reordered by descending alignment (see compact_tuple). Offsets are
+// indexed by logical position.
+template <class L, class Seq = std::make_index_sequence<list_size<L>::value>>
+struct list_compact_offsets;
+
+template <class L, size_t... Is>
+struct list_compact_offsets<L, std::index_sequence<Is...>> {
+    static constexpr std::array<size_t, sizeof...(Is)> value = {
+        {list_offsets<compact_list_t<L>>::value[alignment_order<L>::position(Is)]...}};
+};
+
+template <class L, size_t... Is>
+constexpr std::array<size_t, sizeof...(Is)>
+    list_compact_offsets<L, std::index_sequence<Is...>>::value;
+
+template <class L>
+using list_compact_layout_size = list_layout_size<compact_list_t<L>>;
+
+template <class L>
+using list_padding_saved =
+    index_constant<list_layout_size<L>::value - list_compact_layout_size<L>::value>;
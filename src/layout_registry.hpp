@@ -0,0 +1,41 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include "string_key.hpp"
+
+// Schemas walked by the layout_report tool, point LAYOUT_REPORT_REGISTRY to another header
+// defining layout_registry to report on your own.
+using layout_registry = type_map<
+    type_pair<MINIMPL_KEY("particle"),
+              type_map<type_pair<MINIMPL_KEY("alive"), bool>, type_pair<MINIMPL_KEY("x"), double>,
+                       type_pair<MINIMPL_KEY("species"), short>,
+                       type_pair<MINIMPL_KEY("y"), double>, type_pair<MINIMPL_KEY("id"), int>>>,
+    type_pair<MINIMPL_KEY("order"),
+              type_map<type_pair<MINIMPL_KEY("side"), char>,
+                       type_pair<MINIMPL_KEY("price"), double>,
+                       type_pair<MINIMPL_KEY("quantity"), int>>>>;
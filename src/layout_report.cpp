@@ -0,0 +1,63 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "layout_report.hpp"
+
+#ifndef LAYOUT_REPORT_REGISTRY
+#define LAYOUT_REPORT_REGISTRY "layout_registry.hpp"
+#endif
+#include LAYOUT_REPORT_REGISTRY
+
+// usage: layout_report [--max-padding N] [output_file]
+// Prints one JSON line per schema of layout_registry and fails if a schema wastes more than N
+// bytes of padding in declared order.
+int main(int argc, char** argv) {
+    long max_padding = -1;
+    const char* output = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--max-padding") == 0 and i + 1 < argc) {
+            max_padding = std::atol(argv[++i]);
+        } else {
+            output = argv[i];
+        }
+    }
+
+    std::ofstream file;
+    if (output != nullptr) { file.open(output); }
+    layout_report<layout_registry>::write(output != nullptr ? file : std::cout);
+
+    size_t padding = layout_report<layout_registry>::max_padding();
+    if (max_padding >= 0 and padding > size_t(max_padding)) {
+        std::cerr << "layout_report: " << padding << " bytes of padding exceed the budget of "
+                  << max_padding << " bytes\n";
+        return 1;
+    }
+    return 0;
+}
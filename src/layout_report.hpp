@@ -0,0 +1,131 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <algorithm>
+#include <ostream>
+#include <string>
+#include "layout.hpp"
+#include "name_index.hpp"
+#include "type_map.hpp"
+
+template <class Schema>
+struct schema_fields {
+    using values = Schema;
+    static std::string name(size_t i) { return std::to_string(i); }
+};
+
+template <class... Ks, class... Vs>
+struct schema_fields<type_map<type_pair<Ks, Vs>...>> {
+    using values = type_list<Vs...>;
+    static std::string name(size_t i) {
+        const_string names[] = {tag_name<Ks>::get()..., ""};
+        return names[i].str();
+    }
+};
+
+inline void write_json_string(std::ostream& os, const_string s) {
+    os << '"';
+    for (char c : s) {
+        if (c == '"' or c == '\\') { os << '\\'; }
+        os << c;
+    }
+    os << '"';
+}
+
+//==================================================================================================
+// One JSON object per schema and per line, fields listed in memory order.
+template <class Schema>
+struct schema_layout_report {
+    using fields = schema_fields<Schema>;
+    using values = typename fields::values;
+    static constexpr size_t n = list_size<values>::value;
+
+    template <class... Ts>
+    static std::array<const_string, sizeof...(Ts)> type_names(type_list<Ts...>) {
+        return {{type_name<Ts>()...}};
+    }
+
+    static void write_layout(std::ostream& os, const std::array<size_t, n>& offsets, size_t size,
+                             size_t padding) {
+        const auto& sizes = list_layout<values>::sizes::value;
+        const auto& alignments = list_layout<values>::alignments::value;
+        auto types = type_names(values());
+        std::array<size_t, n> order;
+        for (size_t i = 0; i < n; i++) { order[i] = i; }
+        std::sort(order.begin(), order.end(),
+                  [&](size_t a, size_t b) { return offsets[a] < offsets[b]; });
+
+        os << "{\"size\":" << size << ",\"padding\":" << padding << ",\"fields\":[";
+        for (size_t k = 0; k < n; k++) {
+            size_t i = order[k];
+            size_t next = k + 1 < n ? offsets[order[k + 1]] : size;
+            os << (k == 0 ? "" : ",") << "{\"name\":";
+            write_json_string(os, fields::name(i));
+            os << ",\"type\":";
+            write_json_string(os, types[i]);
+            os << ",\"offset\":" << offsets[i] << ",\"size\":" << sizes[i]
+               << ",\"align\":" << alignments[i]
+               << ",\"padding\":" << next - offsets[i] - sizes[i] << "}";
+        }
+        os << "]}";
+    }
+
+    static void write(std::ostream& os, const_string name) {
+        os << "{\"schema\":";
+        write_json_string(os, name);
+        os << ",\"align\":" << list_layout_align<values>::value << ",\"declared\":";
+        write_layout(os, list_offsets<values>::value, list_layout_size<values>::value,
+                     list_layout_padding<values>::value);
+        os << ",\"compact\":";
+        write_layout(os, list_compact_offsets<values>::value,
+                     list_compact_layout_size<values>::value,
+                     list_layout_padding<compact_list_t<values>>::value);
+        os << ",\"padding_saved\":" << list_padding_saved<values>::value << "}\n";
+    }
+};
+
+//==================================================================================================
+// Registry is a type_map from schema names (string keys or tags) to type_lists or type_maps.
+template <class Registry>
+struct layout_report;
+
+template <class... Names, class... Schemas>
+struct layout_report<type_map<type_pair<Names, Schemas>...>> {
+    static void write(std::ostream& os) {
+        int dummy[] = {0,
+                       (schema_layout_report<Schemas>::write(os, tag_name<Names>::get()), 0)...};
+        (void)dummy;
+    }
+
+    // largest padding of a schema in declared order
+    static size_t max_padding() {
+        size_t paddings[] = {
+            0, list_layout_padding<typename schema_fields<Schemas>::values>::value...};
+        return *std::max_element(std::begin(paddings), std::end(paddings));
+    }
+};
@@ -0,0 +1,157 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <cstring>
+#include <vector>
+#include "soa_vector.hpp"
+
+enum class key_migration { add, copy, convert };
+
+// how the values of a key of NewM are obtained from OldM: default-filled if the key is new,
+// memcpy'd if it has the same trivially copyable type in both maps, converted otherwise
+template <class Key, class OldM, class NewM,
+          bool kept = list_contains<Key, map_key_list_t<OldM>>::value>
+struct key_migration_of : std::integral_constant<key_migration, key_migration::add> {};
+
+template <class Key, class OldM, class NewM>
+struct key_migration_of<Key, OldM, NewM, true>
+    : std::integral_constant<
+          key_migration,
+          std::is_same<record_element_t<Key, OldM>, record_element_t<Key, NewM>>::value and
+                  std::is_trivially_copyable<record_element_t<Key, NewM>>::value
+              ? key_migration::copy
+              : key_migration::convert> {};
+
+template <key_migration kind>
+using key_migration_constant = std::integral_constant<key_migration, kind>;
+
+//==================================================================================================
+template <class OldM, class NewM>
+struct map_migration {
+    using old_keys = map_key_list_t<OldM>;
+    using new_keys = map_key_list_t<NewM>;
+
+    template <class Key>
+    using is_kept = list_contains<Key, old_keys>;
+
+    template <class Key>
+    using is_added = std::integral_constant<bool, not list_contains<Key, old_keys>::value>;
+
+    template <class Key>
+    using is_dropped = std::integral_constant<bool, not list_contains<Key, new_keys>::value>;
+
+    template <class Key>
+    using is_copied = std::integral_constant<bool, key_migration_of<Key, OldM, NewM>::value ==
+                                                       key_migration::copy>;
+
+    using kept = list_filter_t<is_kept, new_keys>;
+    using dropped = list_filter_t<is_dropped, old_keys>;
+    using added = list_filter_t<is_added, new_keys>;
+    using copied = list_filter_t<is_copied, new_keys>;  // kept keys with identical types
+
+  private:
+    template <class Key, class From, class To>
+    static void migrate_column(const From&, To& to, key_migration_constant<key_migration::add>) {
+        for (auto& value : to.template column<Key>()) { value = record_element_t<Key, NewM>(); }
+    }
+
+    template <class Key, class From, class To>
+    static void migrate_column(const From& from, To& to,
+                               key_migration_constant<key_migration::copy>) {
+        if (from.size() > 0) {
+            std::memcpy(to.template column<Key>().data(), from.template column<Key>().data(),
+                        from.size() * sizeof(record_element_t<Key, NewM>));
+        }
+    }
+
+    template <class Key, class From, class To>
+    static void migrate_column(const From& from, To& to,
+                               key_migration_constant<key_migration::convert>) {
+        auto source = from.template column<Key>();
+        auto destination = to.template column<Key>();
+        for (size_t i = 0; i < source.size(); i++) {
+            destination[i] = static_cast<record_element_t<Key, NewM>>(source[i]);
+        }
+    }
+
+    template <class Key, class Record>
+    static record_element_t<Key, NewM> migrate_value(const Record&,
+                                                     key_migration_constant<key_migration::add>) {
+        return record_element_t<Key, NewM>();
+    }
+
+    template <class Key, class Record, key_migration kind>
+    static record_element_t<Key, NewM> migrate_value(const Record& record,
+                                                     key_migration_constant<kind>) {
+        return static_cast<record_element_t<Key, NewM>>(record.template get<Key>());
+    }
+
+    template <class From, class... Keys>
+    static void migrate_columns(const From& from, soa_vector<NewM>& to, type_list<Keys...>) {
+        to.resize(from.size());
+        int dummy[] = {0, (migrate_column<Keys>(from, to, key_migration_of<Keys, OldM, NewM>()),
+                           0)...};
+        (void)dummy;
+    }
+
+    template <class Layout, class... Keys>
+    static typed_record<NewM, Layout> migrate_record(const typed_record<OldM, Layout>& record,
+                                                     type_list<Keys...>) {
+        return typed_record<NewM, Layout>(
+            migrate_value<Keys>(record, key_migration_of<Keys, OldM, NewM>())...);
+    }
+
+  public:
+    // From is any column container of OldM with size() and column<Key>() (soa_vector,
+    // columnar_file...)
+    template <class From>
+    static void migrate(const From& from, soa_vector<NewM>& to) {
+        migrate_columns(from, to, new_keys());
+    }
+
+    template <class From>
+    static soa_vector<NewM> migrate(const From& from) {
+        soa_vector<NewM> to;
+        migrate(from, to);
+        return to;
+    }
+
+    template <class Layout>
+    static typed_record<NewM, Layout> migrate(const typed_record<OldM, Layout>& record) {
+        return migrate_record(record, new_keys());
+    }
+
+    template <class Layout>
+    static std::vector<typed_record<NewM, Layout>> migrate(
+        const std::vector<typed_record<OldM, Layout>>& records) {
+        std::vector<typed_record<NewM, Layout>> result;
+        result.reserve(records.size());
+        for (auto& record : records) { result.push_back(migrate(record)); }
+        return result;
+    }
+};
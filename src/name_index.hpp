@@ -0,0 +1,134 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include "type_id.hpp"
+
+template <class T>
+struct tag_name {
+    static constexpr const_string get() { return type_name<T>(); }
+};
+
+constexpr uint64_t hash_mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+constexpr size_t perfect_hash_slot(uint64_t hash, uint64_t seed, size_t n) {
+    return hash_mix(hash + seed * 0x9e3779b97f4a7c15ull) % n;
+}
+
+//==================================================================================================
+// Hash-and-displace: keys are grouped in n buckets by hash, then buckets are placed largest first,
+// each with the first seed that sends all its keys to free slots of an n-slot table.
+template <size_t n>
+struct perfect_hash_table {
+    uint64_t seeds[n];
+    size_t slots[n];
+    bool ok;
+};
+
+template <size_t n>
+constexpr perfect_hash_table<n> make_perfect_hash_table(const std::array<const_string, n>& names,
+                                                        uint64_t max_seed = 1 << 16) {
+    perfect_hash_table<n> table{{}, {}, true};
+    uint64_t hashes[n] = {};
+    size_t bucket_sizes[n] = {};
+    bool placed[n] = {};
+    for (size_t i = 0; i < n; i++) {
+        hashes[i] = fnv1a(names[i]);
+        bucket_sizes[hashes[i] % n]++;
+        table.slots[i] = n;
+    }
+    for (size_t remaining = n; remaining > 0 and table.ok;) {
+        size_t bucket = 0;
+        for (size_t b = 0; b < n; b++) {
+            if (bucket_sizes[b] > bucket_sizes[bucket]) { bucket = b; }
+        }
+        bool found = false;
+        for (uint64_t seed = 0; seed < max_seed and not found; seed++) {
+            bool taken[n] = {};
+            found = true;
+            for (size_t i = 0; i < n and found; i++) {
+                if (hashes[i] % n != bucket) { continue; }
+                size_t slot = perfect_hash_slot(hashes[i], seed, n);
+                found = table.slots[slot] == n and not taken[slot];
+                taken[slot] = true;
+            }
+            if (found) {
+                table.seeds[bucket] = seed;
+                for (size_t i = 0; i < n; i++) {
+                    if (hashes[i] % n == bucket and not placed[i]) {
+                        table.slots[perfect_hash_slot(hashes[i], seed, n)] = i;
+                        placed[i] = true;
+                    }
+                }
+            }
+        }
+        table.ok = found;
+        remaining -= bucket_sizes[bucket];
+        bucket_sizes[bucket] = 0;
+    }
+    return table;
+}
+
+//==================================================================================================
+template <class L>
+struct list_name_index;
+
+template <class... Ts>
+struct list_name_index<type_list<Ts...>> {
+    static constexpr size_t size = sizeof...(Ts);
+    static constexpr std::array<const_string, sizeof...(Ts)> names = {{tag_name<Ts>::get()...}};
+    static constexpr perfect_hash_table<sizeof...(Ts)> table = make_perfect_hash_table(names);
+    static_assert(table.ok, "type names must be distinct");
+
+    // returns the index of the type with this name in the list, or the list size if there is none
+    static size_t find(const_string name) {
+        uint64_t hash = fnv1a(name);
+        size_t i = table.slots[perfect_hash_slot(hash, table.seeds[hash % size], size)];
+        return names[i] == name ? i : size;
+    }
+};
+
+template <>
+struct list_name_index<type_list<>> {
+    static constexpr size_t size = 0;
+    static size_t find(const_string) { return 0; }
+};
+
+template <class... Ts>
+constexpr size_t list_name_index<type_list<Ts...>>::size;
+
+template <class... Ts>
+constexpr std::array<const_string, sizeof...(Ts)> list_name_index<type_list<Ts...>>::names;
+
+template <class... Ts>
+constexpr perfect_hash_table<sizeof...(Ts)> list_name_index<type_list<Ts...>>::table;
@@ -0,0 +1,157 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <array>
+#include <cstring>
+#include "cold.hpp"
+#include "value_list.hpp"
+
+// Writes key_encoder<T>::size bytes whose memcmp order is the order of the values of type T.
+// Specialize for other key types.
+template <class T, class Enable = void>
+struct key_encoder;
+
+template <class U>
+void store_big_endian(U value, unsigned char* out) {
+    for (size_t i = 0; i < sizeof(U); i++) {
+        out[i] = static_cast<unsigned char>(value >> (8 * (sizeof(U) - 1 - i)));
+    }
+}
+
+// integers are stored big-endian, with the sign bit flipped so that negative values come first
+template <class T>
+struct key_encoder<T, std::enable_if_t<std::is_integral<T>::value>> {
+    using bits = std::make_unsigned_t<std::conditional_t<std::is_same<T, bool>::value, char, T>>;
+    static constexpr size_t size = sizeof(T);
+    static constexpr bits sign =
+        std::is_signed<T>::value ? bits(bits(1) << (8 * sizeof(T) - 1)) : bits(0);
+
+    static void encode(T value, unsigned char* out) {
+        store_big_endian(bits(bits(value) ^ sign), out);
+    }
+};
+
+template <class T>
+constexpr size_t key_encoder<T, std::enable_if_t<std::is_integral<T>::value>>::size;
+
+template <class T>
+struct key_encoder<T, std::enable_if_t<std::is_enum<T>::value>>
+    : key_encoder<std::underlying_type_t<T>> {
+    static void encode(T value, unsigned char* out) {
+        key_encoder<std::underlying_type_t<T>>::encode(std::underlying_type_t<T>(value), out);
+    }
+};
+
+// Negative floats have all their bits flipped, positive ones their sign bit: -inf < -1 < -0 < 0 <
+// 1 < inf < nan (positive nans, negative nans come first).
+template <class T>
+struct key_encoder<T, std::enable_if_t<std::is_floating_point<T>::value>> {
+    static_assert(sizeof(T) == 4 or sizeof(T) == 8, "unsupported floating point type");
+    using bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    static constexpr size_t size = sizeof(T);
+
+    static void encode(T value, unsigned char* out) {
+        bits b;
+        std::memcpy(&b, &value, sizeof(b));
+        const bits sign = bits(1) << (8 * sizeof(T) - 1);
+        store_big_endian(bits((b & sign) != 0 ? ~b : b | sign), out);
+    }
+};
+
+template <class T>
+constexpr size_t key_encoder<T, std::enable_if_t<std::is_floating_point<T>::value>>::size;
+
+// fixed-size strings compare as unsigned bytes, shorter zero-padded strings first
+template <size_t n>
+struct key_encoder<std::array<char, n>> {
+    static constexpr size_t size = n;
+
+    static void encode(const std::array<char, n>& value, unsigned char* out) {
+        std::memcpy(out, value.data(), n);
+    }
+};
+
+template <size_t n>
+constexpr size_t key_encoder<std::array<char, n>>::size;
+
+//==================================================================================================
+// sorts on Key in descending order when used in normalized_key
+template <class Key>
+struct descending {};
+
+template <class Key>
+struct sort_key : is_type<Key> {
+    static constexpr bool descending = false;
+};
+
+template <class Key>
+struct sort_key<descending<Key>> : is_type<Key> {
+    static constexpr bool descending = true;
+};
+
+template <class Key>
+using sort_key_t = is_type_t<sort_key<Key>>;
+
+template <class SortKey, class M>
+using sort_key_encoder = key_encoder<record_element_t<sort_key_t<SortKey>, M>>;
+
+template <class SortKey, class M>
+void encode_sort_key(const record_element_t<sort_key_t<SortKey>, M>& value, unsigned char* out) {
+    sort_key_encoder<SortKey, M>::encode(value, out);
+    if (sort_key<SortKey>::descending) {
+        for (size_t i = 0; i < sort_key_encoder<SortKey, M>::size; i++) { out[i] = ~out[i]; }
+    }
+}
+
+//==================================================================================================
+// Bytes of the fields Keys of a record of M, whose memcmp (or std::array) order is the
+// lexicographic order of the fields. Keys wrapped in descending<Key> are sorted in reverse.
+template <class M, class... Keys>
+struct normalized_key {
+    static constexpr size_t size =
+        value_list_sum<index_list<sort_key_encoder<Keys, M>::size...>>::value;
+    using bytes = std::array<unsigned char, size>;
+
+    // Record is anything with get<Key>() for the keys of M (typed_record, soa_row, record_view...)
+    template <class Record>
+    static void encode(const Record& record, unsigned char* out) {
+        int dummy[] = {0, (encode_sort_key<Keys, M>(record.template get<sort_key_t<Keys>>(), out),
+                           out += sort_key_encoder<Keys, M>::size, 0)...};
+        (void)dummy;
+    }
+
+    template <class Record>
+    static bytes encode(const Record& record) {
+        bytes result;
+        encode(record, result.data());
+        return result;
+    }
+};
+
+template <class M, class... Keys>
+constexpr size_t normalized_key<M, Keys...>::size;
@@ -0,0 +1,162 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "type_map.hpp"
+
+template <class T>
+struct bit_width : std::integral_constant<size_t, sizeof(T) * 8> {};
+
+template <>
+struct bit_width<bool> : std::integral_constant<size_t, 1> {};
+
+//==================================================================================================
+// Fields are placed first-fit by decreasing width and never straddle two words. Returns
+// word * word_bits + shift for field i, or the number of words used when i == n.
+template <size_t n>
+constexpr size_t bit_layout_place(const std::array<size_t, n>& widths, size_t word_bits, size_t i) {
+    size_t fill[n + 1] = {};
+    size_t position[n + 1] = {};
+    size_t words = 0;
+    for (size_t r = 0; r < n; r++) {
+        size_t field = 0;
+        for (size_t j = 0; j < n; j++) {
+            size_t rank = 0;
+            for (size_t k = 0; k < n; k++) {
+                if (widths[k] > widths[j] or (widths[k] == widths[j] and k < j)) { rank++; }
+            }
+            if (rank == r) { field = j; }
+        }
+        size_t w = 0;
+        while (w < words and fill[w] + widths[field] > word_bits) { w++; }
+        if (w == words) { words++; }
+        position[field] = w * word_bits + fill[w];
+        fill[w] += widths[field];
+    }
+    return i == n ? words : position[i];
+}
+
+template <class T>
+using is_bit_packable =
+    std::integral_constant<bool, std::is_integral<T>::value or std::is_enum<T>::value>;
+
+template <size_t bits>
+using packed_word_t =
+    std::conditional_t<(bits <= 8), uint8_t,
+                       std::conditional_t<(bits <= 16), uint16_t,
+                                          std::conditional_t<(bits <= 32), uint32_t, uint64_t>>>;
+
+//==================================================================================================
+template <class M>
+class packed_record;
+
+template <class... Keys, class... Values>
+class packed_record<type_map<type_pair<Keys, Values>...>> {
+    static_assert(list_and<is_bit_packable, type_list<Values...>>::value,
+                  "packed_record fields must be integers, bools or enums");
+
+    static constexpr size_t total_bits =
+        list_reduce_to_value<bit_width, std::plus<size_t>, size_t, 0, type_list<Values...>>::value;
+
+  public:
+    using map = type_map<type_pair<Keys, Values>...>;
+    using word_type = packed_word_t<total_bits>;
+    static constexpr size_t word_bits = sizeof(word_type) * 8;
+
+    static constexpr size_t word_count =
+        bit_layout_place(list_map_to_value<bit_width, size_t, type_list<Values...>>::value,
+                         word_bits, sizeof...(Values));
+
+  private:
+    std::array<word_type, word_count> words{};
+
+    template <class Key>
+    struct field {
+        using type = map_element_t<Key, map>;
+        static constexpr size_t index = map_element_index<Key, map>::value;
+        static constexpr size_t width = bit_width<type>::value;
+        static constexpr size_t position = bit_layout_place(
+            list_map_to_value<bit_width, size_t, type_list<Values...>>::value, word_bits, index);
+        static constexpr size_t word = position / word_bits;
+        static constexpr size_t shift = position % word_bits;
+        static constexpr word_type mask =
+            width == word_bits ? word_type(~word_type(0)) : word_type((word_type(1) << width) - 1);
+        static_assert(width > 0 and width <= word_bits, "field does not fit in a word");
+
+        using raw = std::conditional_t<std::is_enum<type>::value, std::underlying_type<type>,
+                                       is_type<type>>;
+        using raw_t = is_type_t<raw>;
+    };
+
+    template <class T>
+    static constexpr T sign_extend(uint64_t bits, size_t width, std::true_type) {
+        return width == 64 ? T(bits) : T(int64_t(bits << (64 - width)) >> (64 - width));
+    }
+
+    template <class T>
+    static constexpr T sign_extend(uint64_t bits, size_t, std::false_type) {
+        return T(bits);
+    }
+
+  public:
+    constexpr packed_record() = default;
+
+    packed_record(const Values&... values) {
+        int dummy[] = {(set<Keys>(values), 0)...};
+        (void)dummy;
+    }
+
+    template <class Key>
+    constexpr map_element_t<Key, map> get() const {
+        using f = field<Key>;
+        using raw_t = typename f::raw_t;
+        return static_cast<typename f::type>(sign_extend<raw_t>(
+            (words[f::word] >> f::shift) & f::mask, f::width,
+            std::integral_constant<bool, std::is_signed<raw_t>::value>()));
+    }
+
+    template <class Key>
+    void set(const map_element_t<Key, map>& value) {
+        using f = field<Key>;
+        auto bits = word_type(static_cast<typename f::raw_t>(value)) & f::mask;
+        words[f::word] = word_type((words[f::word] & ~word_type(f::mask << f::shift)) |
+                                   word_type(bits << f::shift));
+    }
+};
+
+template <class... Keys, class... Values>
+constexpr size_t packed_record<type_map<type_pair<Keys, Values>...>>::word_bits;
+
+template <class... Keys, class... Values>
+constexpr size_t packed_record<type_map<type_pair<Keys, Values>...>>::word_count;
+
+template <class Key, class M>
+constexpr auto get(const packed_record<M>& r) {
+    return r.template get<Key>();
+}
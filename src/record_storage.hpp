@@ -0,0 +1,172 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "type_list.hpp"
+
+constexpr size_t round_up(size_t x, size_t alignment) {
+    return (x + alignment - 1) / alignment * alignment;
+}
+
+// offset of element i when laid out like a struct, or the end of the last element if i == n
+template <size_t n>
+constexpr size_t layout_offset(const std::array<size_t, n>& sizes,
+                               const std::array<size_t, n>& alignments, size_t i) {
+    size_t offset = 0;
+    for (size_t j = 0; j < i; j++) {
+        offset = round_up(offset, alignments[j]) + sizes[j];
+    }
+    return i < n ? round_up(offset, alignments[i]) : offset;
+}
+
+template <size_t n>
+constexpr size_t layout_alignment(const std::array<size_t, n>& alignments) {
+    size_t result = 1;
+    for (size_t i = 0; i < n; i++) { result = alignments[i] > result ? alignments[i] : result; }
+    return result;
+}
+
+//==================================================================================================
+// Fields are laid out like the members of a flat struct (a nested head/tail struct would round the
+// tail up to its own alignment and add padding). Trivially copyable fields are stored in a byte
+// buffer at these offsets, which keeps records standard-layout. Other fields are separate bases.
+template <class... Ts>
+struct record_bytes {
+    static constexpr std::array<size_t, sizeof...(Ts)> sizes = {{sizeof(Ts)...}};
+    static constexpr std::array<size_t, sizeof...(Ts)> alignments = {{alignof(Ts)...}};
+    static constexpr size_t size =
+        round_up(layout_offset(sizes, alignments, sizeof...(Ts)), layout_alignment(alignments));
+
+    alignas(layout_alignment(alignments)) unsigned char bytes[size];
+
+    record_bytes() = default;
+    record_bytes(const Ts&... values) { construct(std::index_sequence_for<Ts...>(), values...); }
+
+    template <size_t... Is>
+    void construct(std::index_sequence<Is...>, const Ts&... values) {
+        int dummy[] = {0, (new (bytes + layout_offset(sizes, alignments, Is)) Ts(values), 0)...};
+        (void)dummy;
+    }
+
+    template <size_t i>
+    pack_element_t<i, Ts...>& field() {
+        constexpr size_t offset = layout_offset(sizes, alignments, i);
+        return *reinterpret_cast<pack_element_t<i, Ts...>*>(bytes + offset);
+    }
+
+    template <size_t i>
+    const pack_element_t<i, Ts...>& field() const {
+        constexpr size_t offset = layout_offset(sizes, alignments, i);
+        return *reinterpret_cast<const pack_element_t<i, Ts...>*>(bytes + offset);
+    }
+};
+
+template <class... Ts>
+constexpr std::array<size_t, sizeof...(Ts)> record_bytes<Ts...>::sizes;
+
+template <class... Ts>
+constexpr std::array<size_t, sizeof...(Ts)> record_bytes<Ts...>::alignments;
+
+template <class... Ts>
+constexpr size_t record_bytes<Ts...>::size;
+
+template <size_t i, class T>
+struct record_field {
+    T value;
+};
+
+template <class Seq, class... Ts>
+struct record_fields;
+
+template <size_t... Is, class... Ts>
+struct record_fields<std::index_sequence<Is...>, Ts...> : record_field<Is, Ts>... {
+    record_fields() = default;
+    constexpr record_fields(const Ts&... values) : record_field<Is, Ts>{values}... {}
+};
+
+template <class... Ts>
+struct record_storage;
+
+template <>
+struct record_storage<> {};
+
+template <class... Ts>
+using record_storage_base =
+    std::conditional_t<list_and<std::is_trivially_copyable, type_list<Ts...>>::value,
+                       record_bytes<Ts...>, record_fields<std::index_sequence_for<Ts...>, Ts...>>;
+
+template <class T, class... Ts>
+struct record_storage<T, Ts...> : record_storage_base<T, Ts...> {
+    record_storage() = default;
+    constexpr record_storage(const T& head, const Ts&... tail)
+        : record_storage_base<T, Ts...>(head, tail...) {}
+};
+
+//==================================================================================================
+template <size_t i, class T>
+constexpr T& record_field_get(record_field<i, T>& field) {
+    return field.value;
+}
+
+template <size_t i, class T>
+constexpr const T& record_field_get(const record_field<i, T>& field) {
+    return field.value;
+}
+
+template <size_t i, class... Ts>
+constexpr auto& record_field_get(record_bytes<Ts...>& bytes) {
+    return bytes.template field<i>();
+}
+
+template <size_t i, class... Ts>
+constexpr const auto& record_field_get(const record_bytes<Ts...>& bytes) {
+    return bytes.template field<i>();
+}
+
+template <size_t i, class... Ts>
+constexpr auto& get(record_storage<Ts...>& s) {
+    return record_field_get<i>(s);
+}
+
+template <size_t i, class... Ts>
+constexpr auto& get(const record_storage<Ts...>& s) {
+    return record_field_get<i>(s);
+}
+
+//==================================================================================================
+template <class L>
+struct list_record_storage;
+
+template <class L>
+using list_record_storage_t = is_type_t<list_record_storage<L>>;
+
+template <class... Ts>
+struct list_record_storage<type_list<Ts...>> : is_type<record_storage<Ts...>> {};
@@ -0,0 +1,115 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include "column_convert.hpp"
+#include "layout.hpp"
+#include "typed_record.hpp"
+
+template <class Layout, class L>
+struct layout_offsets : list_offsets<L> {
+    static constexpr size_t size = list_layout_size<L>::value;
+};
+
+template <class L>
+struct layout_offsets<compact_layout, L> : list_compact_offsets<L> {
+    static constexpr size_t size = list_compact_layout_size<L>::value;
+};
+
+template <class Layout, class L>
+constexpr size_t layout_offsets<Layout, L>::size;
+
+template <class L>
+constexpr size_t layout_offsets<compact_layout, L>::size;
+
+//==================================================================================================
+// Typed view over a record stored in a byte buffer (shared memory, mmap'd file...) with the
+// layout of typed_record<M, Layout>. Fields are read by value with memcpy, so the buffer does not
+// need to be aligned, and byte-swapped if the buffer byte order is not the native one. Like in
+// typed_record, cold<T> fields are stored as T.
+template <class M, class Layout = declared_layout, byte_order order = byte_order::native>
+class record_view {
+    using values = list_map_t<uncold_t, map_value_list_t<M>>;
+    static_assert(list_and<std::is_trivially_copyable, values>::value,
+                  "record_view fields must be trivially copyable");
+
+  protected:
+    using offsets = layout_offsets<Layout, values>;
+
+    template <class Key>
+    using offset = index_constant<offsets::value[map_element_index<Key, M>::value]>;
+
+    const unsigned char* data_;
+
+  public:
+    using map = M;
+    static constexpr size_t size = offsets::size;  // distance between consecutive records
+
+    explicit record_view(const void* data) : data_(static_cast<const unsigned char*>(data)) {}
+
+    template <class Key>
+    record_element_t<Key, M> get() const {
+        return load_bytes<record_element_t<Key, M>, order>(data_ + offset<Key>::value);
+    }
+
+    const unsigned char* data() const { return data_; }
+
+    // view of the i-th record of a buffer of records
+    record_view at(size_t i) const { return record_view(data_ + i * size); }
+
+    // loads field Key of the n records starting at this one into out, converted to To
+    template <class Key, class To>
+    void read_column(size_t n, To* out) const {
+        load_column<record_element_t<Key, M>>(data_ + offset<Key>::value, n, out, order, size);
+    }
+};
+
+template <class M, class Layout, byte_order order>
+constexpr size_t record_view<M, Layout, order>::size;
+
+template <class M, class Layout = declared_layout, byte_order order = byte_order::native>
+class mutable_record_view : public record_view<M, Layout, order> {
+    using base = record_view<M, Layout, order>;
+
+  public:
+    explicit mutable_record_view(void* data) : base(data) {}
+
+    template <class Key>
+    void set(const record_element_t<Key, M>& value) const {
+        store_bytes<record_element_t<Key, M>, order>(data() + base::template offset<Key>::value,
+                                                      value);
+    }
+
+    unsigned char* data() const { return const_cast<unsigned char*>(this->data_); }
+
+    mutable_record_view at(size_t i) const { return mutable_record_view(data() + i * base::size); }
+};
+
+template <class Key, class M, class Layout, byte_order order>
+record_element_t<Key, M> get(const record_view<M, Layout, order>& view) {
+    return view.template get<Key>();
+}
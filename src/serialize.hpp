@@ -0,0 +1,306 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "aligned_vector.hpp"
+#include "layout.hpp"
+#include "typed_record.hpp"
+
+// Encoding of a field that is not trivially copyable: size, write (returns the end of the
+// written bytes) and read (returns the end of the read bytes, or nullptr if [in, end) is too
+// short). Sequences are written as a uint64_t element count followed by the elements.
+template <class T, class Enable = void>
+struct field_codec {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "field_codec must be specialized for this type to be serialized");
+};
+
+template <class T>
+struct sequence_codec {
+    static_assert(std::is_trivially_copyable<typename T::value_type>::value,
+                  "sequence elements must be trivially copyable");
+    using value_type = typename T::value_type;
+
+    static size_t size(const T& value) {
+        return sizeof(uint64_t) + value.size() * sizeof(value_type);
+    }
+
+    static char* write(const T& value, char* out) {
+        uint64_t count = value.size();
+        std::memcpy(out, &count, sizeof(count));
+        if (count > 0) { std::memcpy(out + sizeof(count), &value[0], count * sizeof(value_type)); }
+        return out + size(value);
+    }
+
+    static const char* read(const char* in, const char* end, T& value) {
+        uint64_t count;
+        if (size_t(end - in) < sizeof(count)) { return nullptr; }
+        std::memcpy(&count, in, sizeof(count));
+        in += sizeof(count);
+        if (count > size_t(end - in) / sizeof(value_type)) { return nullptr; }
+        value.resize(count);
+        if (count > 0) { std::memcpy(&value[0], in, count * sizeof(value_type)); }
+        return in + count * sizeof(value_type);
+    }
+};
+
+template <class Char, class Traits, class Alloc>
+struct field_codec<std::basic_string<Char, Traits, Alloc>>
+    : sequence_codec<std::basic_string<Char, Traits, Alloc>> {};
+
+template <class T, class Alloc>
+struct field_codec<std::vector<T, Alloc>> : sequence_codec<std::vector<T, Alloc>> {};
+
+//==================================================================================================
+enum class field_encoding { run_start, in_run, codec };
+
+template <size_t n>
+constexpr size_t trivial_run_end(const std::array<bool, n>& trivial, size_t i) {
+    while (i < n and trivial[i]) { i++; }
+    return i;
+}
+
+template <size_t n>
+constexpr field_encoding encoding_of(const std::array<bool, n>& trivial, size_t i) {
+    return not trivial[i] ? field_encoding::codec
+                          : i == 0 or not trivial[i - 1] ? field_encoding::run_start
+                                                         : field_encoding::in_run;
+}
+
+template <field_encoding e>
+using field_encoding_constant = std::integral_constant<field_encoding, e>;
+
+// Maximal runs of consecutive trivially copyable fields of a record_storage (in physical order) are
+// copied with a single memcpy, the padding between them being zeroed so that equal records have
+// equal encodings. Other fields use field_codec.
+template <class S>
+struct storage_codec;
+
+template <class... Ts>
+struct storage_codec<record_storage<Ts...>> {
+    using storage = record_storage<Ts...>;
+    static constexpr std::array<bool, sizeof...(Ts)> trivial = {
+        {std::is_trivially_copyable<Ts>::value...}};
+
+    template <size_t i>
+    using encoding = field_encoding_constant<encoding_of(trivial, i)>;
+
+    // bytes of the run starting at field i
+    template <size_t i>
+    static size_t run_size(const storage& s) {
+        constexpr size_t last = trivial_run_end(trivial, i) - 1;
+        return size_t(reinterpret_cast<const char*>(&get<last>(s)) +
+                      sizeof(pack_element_t<last, Ts...>) -
+                      reinterpret_cast<const char*>(&get<i>(s)));
+    }
+
+    // zeroes the padding between the fields of the run starting at field i, copied at out
+    template <size_t i>
+    static void clear_padding(char* out) {
+        constexpr size_t last = trivial_run_end(trivial, i) - 1;
+        const auto& offsets = list_offsets<type_list<Ts...>>::value;
+        const size_t sizes[] = {sizeof(Ts)...};
+        for (size_t j = i; j < last; j++) {
+            size_t end = offsets[j] + sizes[j];
+            std::memset(out + end - offsets[i], 0, offsets[j + 1] - end);
+        }
+    }
+
+    template <size_t i>
+    static size_t size(const storage& s, field_encoding_constant<field_encoding::run_start>) {
+        return run_size<i>(s);
+    }
+
+    template <size_t i>
+    static size_t size(const storage&, field_encoding_constant<field_encoding::in_run>) {
+        return 0;
+    }
+
+    template <size_t i>
+    static size_t size(const storage& s, field_encoding_constant<field_encoding::codec>) {
+        return field_codec<pack_element_t<i, Ts...>>::size(get<i>(s));
+    }
+
+    template <size_t i>
+    static char* write(const storage& s, char* out,
+                       field_encoding_constant<field_encoding::run_start>) {
+        std::memcpy(out, &get<i>(s), run_size<i>(s));
+        clear_padding<i>(out);
+        return out + run_size<i>(s);
+    }
+
+    template <size_t i>
+    static char* write(const storage&, char* out, field_encoding_constant<field_encoding::in_run>) {
+        return out;
+    }
+
+    template <size_t i>
+    static char* write(const storage& s, char* out,
+                       field_encoding_constant<field_encoding::codec>) {
+        return field_codec<pack_element_t<i, Ts...>>::write(get<i>(s), out);
+    }
+
+    template <size_t i>
+    static const char* read(storage& s, const char* in, const char* end,
+                            field_encoding_constant<field_encoding::run_start>) {
+        if (in == nullptr or size_t(end - in) < run_size<i>(s)) { return nullptr; }
+        std::memcpy(&get<i>(s), in, run_size<i>(s));
+        return in + run_size<i>(s);
+    }
+
+    template <size_t i>
+    static const char* read(storage&, const char* in, const char*,
+                            field_encoding_constant<field_encoding::in_run>) {
+        return in;
+    }
+
+    template <size_t i>
+    static const char* read(storage& s, const char* in, const char* end,
+                            field_encoding_constant<field_encoding::codec>) {
+        return in == nullptr ? nullptr
+                             : field_codec<pack_element_t<i, Ts...>>::read(in, end, get<i>(s));
+    }
+
+    template <size_t... Is>
+    static size_t size(const storage& s, std::index_sequence<Is...>) {
+        size_t sizes[] = {0, size<Is>(s, encoding<Is>())...};
+        size_t result = 0;
+        for (size_t x : sizes) { result += x; }
+        return result;
+    }
+
+    template <size_t... Is>
+    static char* write(const storage& s, char* out, std::index_sequence<Is...>) {
+        int dummy[] = {0, (out = write<Is>(s, out, encoding<Is>()), 0)...};
+        (void)dummy;
+        return out;
+    }
+
+    template <size_t... Is>
+    static const char* read(storage& s, const char* in, const char* end,
+                            std::index_sequence<Is...>) {
+        int dummy[] = {0, (in = read<Is>(s, in, end, encoding<Is>()), 0)...};
+        (void)dummy;
+        return in;
+    }
+};
+
+template <class... Ts>
+constexpr std::array<bool, sizeof...(Ts)> storage_codec<record_storage<Ts...>>::trivial;
+
+template <class... Ts>
+record_storage<Ts...>& physical_storage(record_storage<Ts...>& s) {
+    return s;
+}
+
+template <class... Ts>
+const record_storage<Ts...>& physical_storage(const record_storage<Ts...>& s) {
+    return s;
+}
+
+template <class L>
+auto& physical_storage(compact_tuple<L>& t) {
+    return t.data;
+}
+
+template <class L>
+const auto& physical_storage(const compact_tuple<L>& t) {
+    return t.data;
+}
+
+//==================================================================================================
+// Binary encoding of typed_records, in the physical field order of their layout and the native
+// byte order: both ends must use the same map and layout.
+template <class M, class Layout>
+size_t serialized_size(const typed_record<M, Layout>& record) {
+    auto& s = physical_storage(record.data);
+    using codec = storage_codec<std::decay_t<decltype(s)>>;
+    return codec::size(s, std::make_index_sequence<list_size<map_value_list_t<M>>::value>());
+}
+
+template <class M, class Layout>
+char* serialize(const typed_record<M, Layout>& record, char* out) {
+    auto& s = physical_storage(record.data);
+    using codec = storage_codec<std::decay_t<decltype(s)>>;
+    return codec::write(s, out, std::make_index_sequence<list_size<map_value_list_t<M>>::value>());
+}
+
+// appends the encoding of record to out
+template <class M, class Layout>
+void serialize(const typed_record<M, Layout>& record, std::vector<char>& out) {
+    size_t size = out.size();
+    out.resize(size + serialized_size(record));
+    serialize(record, out.data() + size);
+}
+
+// reads a record from [in, end) and returns the end of its encoding, throws if it is truncated
+template <class M, class Layout>
+const char* deserialize(const char* in, const char* end, typed_record<M, Layout>& record) {
+    auto& s = physical_storage(record.data);
+    using codec = storage_codec<std::decay_t<decltype(s)>>;
+    in = codec::read(s, in, end, std::make_index_sequence<list_size<map_value_list_t<M>>::value>());
+    if (in == nullptr) { throw std::runtime_error("truncated record"); }
+    return in;
+}
+
+//==================================================================================================
+// Batches are a uint64_t record count followed by the records.
+template <class M, class Layout>
+void serialize(column_span<const typed_record<M, Layout>> records, std::vector<char>& out) {
+    uint64_t count = records.size();
+    size_t size = out.size();
+    size_t total = sizeof(count);
+    for (auto& record : records) { total += serialized_size(record); }
+    out.resize(size + total);
+    char* p = out.data() + size;
+    std::memcpy(p, &count, sizeof(count));
+    p += sizeof(count);
+    for (auto& record : records) { p = serialize(record, p); }
+}
+
+template <class M, class Layout>
+void serialize(const std::vector<typed_record<M, Layout>>& records, std::vector<char>& out) {
+    serialize(column_span<const typed_record<M, Layout>>(records.data(), records.size()), out);
+}
+
+template <class M, class Layout>
+const char* deserialize(const char* in, const char* end,
+                        std::vector<typed_record<M, Layout>>& records) {
+    uint64_t count;
+    if (size_t(end - in) < sizeof(count)) { throw std::runtime_error("truncated batch"); }
+    std::memcpy(&count, in, sizeof(count));
+    in += sizeof(count);
+    for (uint64_t i = 0; i < count; i++) {  // not resized upfront as count is not trusted yet
+        records.emplace_back();
+        in = deserialize(in, end, records.back());
+    }
+    return in;
+}
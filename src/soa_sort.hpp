@@ -0,0 +1,136 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <cstring>
+#include <exception>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "normalized_key.hpp"
+#include "soa_vector.hpp"
+
+enum class execution { sequential, parallel };
+
+template <class SortKey, class M>
+void encode_sort_column(const soa_vector<M>& vector, unsigned char* out, size_t stride) {
+    auto column = vector.template column<sort_key_t<SortKey>>();
+    for (size_t i = 0; i < column.size(); i++) {
+        encode_sort_key<SortKey, M>(column[i], out + i * stride);
+    }
+}
+
+// Permutation sorting the rows of vector by SortKeys (keys of M, or descending<Key>), stable:
+// row i of the sorted vector is row permutation[i] of vector. The normalized keys of the rows are
+// built once, then sorted with one LSD radix pass per byte, skipping bytes shared by all rows.
+template <class... SortKeys, class M>
+std::vector<size_t> radix_sort_permutation(const soa_vector<M>& vector) {
+    constexpr size_t size = normalized_key<M, SortKeys...>::size;
+    const size_t n = vector.size();
+    std::vector<unsigned char> keys(n * size), next_keys(n * size);
+    size_t offset = 0;
+    int dummy[] = {0, (encode_sort_column<SortKeys>(vector, keys.data() + offset, size),
+                       offset += sort_key_encoder<SortKeys, M>::size, 0)...};
+    (void)dummy;
+
+    std::vector<size_t> counts(size * 256);  // histograms of all bytes in one pass
+    for (size_t i = 0; i < n; i++) {
+        for (size_t b = 0; b < size; b++) { counts[b * 256 + keys[i * size + b]]++; }
+    }
+
+    std::vector<size_t> permutation(n), next(n);
+    std::iota(permutation.begin(), permutation.end(), size_t(0));
+    for (size_t b = size; b-- > 0;) {
+        size_t* count = counts.data() + b * 256;
+        if (n == 0 or count[keys[b]] == n) { continue; }
+        size_t position = 0;
+        for (size_t byte = 0; byte < 256; byte++) {
+            size_t c = count[byte];
+            count[byte] = position;
+            position += c;
+        }
+        for (size_t i = 0; i < n; i++) {
+            size_t destination = count[keys[i * size + b]]++;
+            next[destination] = permutation[i];
+            std::memcpy(next_keys.data() + destination * size, keys.data() + i * size, size);
+        }
+        permutation.swap(next);
+        keys.swap(next_keys);
+    }
+    return permutation;
+}
+
+// moves row permutation[i] of vector to row i, with one gather pass per column, columns being
+// gathered by different threads with execution::parallel. Throws std::invalid_argument, leaving
+// vector unchanged, unless permutation has one index below vector.size() per row. An exception
+// thrown while gathering a column is rethrown once all threads are joined, vector still having
+// vector.size() rows but some of them moved-from.
+template <class M>
+void apply_permutation(soa_vector<M>& vector, const std::vector<size_t>& permutation,
+                       execution policy = execution::sequential) {
+    if (permutation.size() != vector.size()) {
+        throw std::invalid_argument("apply_permutation: permutation and vector sizes differ");
+    }
+    for (size_t i : permutation) {
+        if (i >= vector.size()) {
+            throw std::invalid_argument("apply_permutation: index out of range");
+        }
+    }
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> errors(list_size<map_key_list_t<M>>::value);
+    size_t column_index = 0;
+    try {
+        vector.for_each_column([&](auto& column) {
+            auto gather = [&column, &permutation, &error = errors[column_index++]] {
+                try {
+                    std::decay_t<decltype(column)> sorted;  // values are moved, column is replaced
+                    sorted.reserve(column.size());
+                    for (size_t i : permutation) { sorted.push_back(std::move(column[i])); }
+                    column = std::move(sorted);
+                } catch (...) { error = std::current_exception(); }
+            };
+            if (policy == execution::parallel) {
+                threads.emplace_back(gather);
+            } else {
+                gather();
+            }
+        });
+    } catch (...) {  // a thread could not be started, the running ones must still be joined
+        for (auto& thread : threads) { thread.join(); }
+        throw;
+    }
+    for (auto& thread : threads) { thread.join(); }
+    for (auto& error : errors) {
+        if (error) { std::rethrow_exception(error); }
+    }
+}
+
+template <class... SortKeys, class M>
+void radix_sort(soa_vector<M>& vector, execution policy = execution::sequential) {
+    apply_permutation(vector, radix_sort_permutation<SortKeys...>(vector), policy);
+}
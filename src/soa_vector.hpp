@@ -0,0 +1,144 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include "aligned_vector.hpp"
+#include "typed_record.hpp"
+
+template <class Vector>
+struct soa_row {
+    Vector* vector;
+    size_t index;
+
+    template <class Key>
+    auto& get() const {
+        return vector->template get<Key>(index);
+    }
+};
+
+template <class Key, class Vector>
+auto& get(const soa_row<Vector>& row) {
+    return row.template get<Key>();
+}
+
+//==================================================================================================
+template <class M>
+class soa_vector;
+
+template <class... Keys, class... Values>
+class soa_vector<type_map<type_pair<Keys, Values>...>> {
+    std::tuple<aligned_vector<uncold_t<Values>>...> columns;
+    size_t size_{0};
+
+    template <class F, size_t... Is>
+    void for_each_column(F&& f, std::index_sequence<Is...>) {
+        int dummy[] = {(f(std::get<Is>(columns)), 0)...};
+        (void)dummy;
+    }
+
+    // if a column throws, the values already appended to the others are removed
+    template <size_t... Is>
+    void push_back(std::index_sequence<Is...>, const uncold_t<Values>&... values) {
+        try {
+            int dummy[] = {(std::get<Is>(columns).push_back(values), 0)...};
+            (void)dummy;
+        } catch (...) {
+            for_each_column([this](auto& column) {
+                if (column.size() > size_) { column.pop_back(); }
+            });
+            throw;
+        }
+        size_++;
+    }
+
+  public:
+    using map = type_map<type_pair<Keys, Values>...>;
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    void reserve(size_t n) {
+        for_each_column([n](auto& column) { column.reserve(n); });
+    }
+
+    // if a column throws, all columns are restored to the previous size
+    void resize(size_t n) {
+        try {
+            for_each_column([n](auto& column) { column.resize(n); });
+        } catch (...) {
+            for_each_column([this](auto& column) { column.resize(size_); });
+            throw;
+        }
+        size_ = n;
+    }
+
+    void clear() { resize(0); }
+
+    // calls f on the aligned_vector of each column, which must keep the size of the vector
+    template <class F>
+    void for_each_column(F&& f) {
+        for_each_column(std::forward<F>(f), std::index_sequence_for<Values...>());
+    }
+
+    void push_back(const uncold_t<Values>&... values) {
+        push_back(std::index_sequence_for<Values...>(), values...);
+    }
+
+    template <class Layout>
+    void push_back(const typed_record<map, Layout>& record) {
+        push_back(record.template get<Keys>()...);
+    }
+
+    template <class Key>
+    column_span<record_element_t<Key, map>> column() {
+        auto& c = std::get<map_element_index<Key, map>::value>(columns);
+        return {c.data(), size_};
+    }
+
+    template <class Key>
+    column_span<const record_element_t<Key, map>> column() const {
+        auto& c = std::get<map_element_index<Key, map>::value>(columns);
+        return {c.data(), size_};
+    }
+
+    template <class Key>
+    record_element_t<Key, map>& get(size_t i) {
+        return std::get<map_element_index<Key, map>::value>(columns)[i];
+    }
+
+    template <class Key>
+    const record_element_t<Key, map>& get(size_t i) const {
+        return std::get<map_element_index<Key, map>::value>(columns)[i];
+    }
+
+    soa_row<soa_vector> operator[](size_t i) { return {this, i}; }
+    soa_row<const soa_vector> operator[](size_t i) const { return {this, i}; }
+
+    typed_record<map> record(size_t i) const {
+        return typed_record<map>(get<Keys>(i)...);
+    }
+};
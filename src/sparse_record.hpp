@@ -0,0 +1,197 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include "layout.hpp"
+#include "type_map.hpp"
+
+inline size_t popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (x * 0x0101010101010101ull) >> 56;
+#endif
+}
+
+template <size_t n>
+constexpr size_t size_plane_count(const std::array<size_t, n>& sizes) {
+    size_t result = 0;
+    for (size_t i = 0; i < n; i++) {
+        while ((sizes[i] >> result) != 0) { result++; }
+    }
+    return result;
+}
+
+template <size_t n>
+constexpr uint64_t size_plane_word(const std::array<size_t, n>& sizes, size_t words, size_t i) {
+    uint64_t result = 0;
+    for (size_t f = 64 * (i % words); f < n and f < 64 * (i % words + 1); f++) {
+        if ((sizes[f] >> (i / words)) & 1) { result |= uint64_t(1) << (f % 64); }
+    }
+    return result;
+}
+
+template <size_t n, size_t... Is>
+constexpr std::array<uint64_t, sizeof...(Is)> size_planes(const std::array<size_t, n>& sizes,
+                                                          size_t words,
+                                                          std::index_sequence<Is...>) {
+    return {{size_plane_word(sizes, words, Is)...}};
+}
+
+//==================================================================================================
+// Present values are stored back to back in key order. Bit plane b of the schema marks the fields
+// whose size has bit b set, so the offset of field k is the sum over planes of
+// popcount(present & plane & fields before k) << b.
+template <class M>
+class sparse_record;
+
+template <class... Keys, class... Values>
+class sparse_record<type_map<type_pair<Keys, Values>...>> {
+    static_assert(list_and<std::is_trivially_copyable, type_list<Values...>>::value,
+                  "sparse_record values must be trivially copyable");
+
+  public:
+    using map = type_map<type_pair<Keys, Values>...>;
+    static constexpr size_t field_count = sizeof...(Values);
+    static constexpr size_t mask_words = (field_count + 63) / 64;
+
+  private:
+    using sizes = list_map_to_value<size_of, size_t, type_list<Values...>>;
+
+    static constexpr size_t planes = size_plane_count(sizes::value);
+    static constexpr std::array<uint64_t, planes * mask_words> plane_masks =
+        size_planes(sizes::value, mask_words, std::make_index_sequence<planes * mask_words>());
+
+    std::array<uint64_t, mask_words> mask{};
+    std::unique_ptr<unsigned char[]> data;
+
+    size_t offset(size_t k) const {
+        size_t result = 0;
+        for (size_t w = 0; w < mask_words and 64 * w < k; w++) {
+            uint64_t before = k >= 64 * (w + 1) ? ~uint64_t(0) : (uint64_t(1) << (k % 64)) - 1;
+            uint64_t present = mask[w] & before;
+            for (size_t b = 0; b < planes; b++) {
+                result += popcount64(present & plane_masks[b * mask_words + w]) << b;
+            }
+        }
+        return result;
+    }
+
+    bool has(size_t k) const { return (mask[k / 64] >> (k % 64)) & 1; }
+
+  public:
+    sparse_record() = default;
+
+    sparse_record(const sparse_record& other) : mask(other.mask) {
+        size_t n = other.byte_size();
+        if (n > 0) {
+            data.reset(new unsigned char[n]);
+            std::memcpy(data.get(), other.data.get(), n);
+        }
+    }
+
+    // a moved-from record is empty
+    sparse_record(sparse_record&& other) noexcept : mask(other.mask), data(std::move(other.data)) {
+        other.mask = {};
+    }
+
+    sparse_record& operator=(sparse_record other) noexcept {
+        mask = other.mask;
+        data = std::move(other.data);
+        other.mask = {};
+        return *this;
+    }
+
+    size_t byte_size() const { return offset(field_count); }
+
+    template <class Key>
+    bool has() const {
+        return has(map_element_index<Key, map>::value);
+    }
+
+    // returns a value-initialized value when the field is absent
+    template <class Key>
+    map_element_t<Key, map> get() const {
+        constexpr size_t k = map_element_index<Key, map>::value;
+        map_element_t<Key, map> result{};
+        if (has(k)) { std::memcpy(&result, data.get() + offset(k), sizeof(result)); }
+        return result;
+    }
+
+    template <class Key>
+    void set(const map_element_t<Key, map>& value) {
+        constexpr size_t k = map_element_index<Key, map>::value;
+        size_t at = offset(k);
+        if (not has(k)) {
+            size_t n = byte_size();
+            std::unique_ptr<unsigned char[]> grown(new unsigned char[n + sizeof(value)]);
+            if (n > 0) {
+                std::memcpy(grown.get(), data.get(), at);
+                std::memcpy(grown.get() + at + sizeof(value), data.get() + at, n - at);
+            }
+            data = std::move(grown);
+            mask[k / 64] |= uint64_t(1) << (k % 64);
+        }
+        std::memcpy(data.get() + at, &value, sizeof(value));
+    }
+
+    template <class Key>
+    void reset() {
+        constexpr size_t k = map_element_index<Key, map>::value;
+        if (not has(k)) { return; }
+        size_t at = offset(k), n = byte_size(), size = sizeof(map_element_t<Key, map>);
+        std::memmove(data.get() + at, data.get() + at + size, n - at - size);
+        mask[k / 64] &= ~(uint64_t(1) << (k % 64));
+    }
+};
+
+template <class... Keys, class... Values>
+constexpr size_t sparse_record<type_map<type_pair<Keys, Values>...>>::field_count;
+
+template <class... Keys, class... Values>
+constexpr size_t sparse_record<type_map<type_pair<Keys, Values>...>>::mask_words;
+
+template <class... Keys, class... Values>
+constexpr size_t sparse_record<type_map<type_pair<Keys, Values>...>>::planes;
+
+template <class... Keys, class... Values>
+constexpr std::array<uint64_t, sparse_record<type_map<type_pair<Keys, Values>...>>::planes *
+                                   sparse_record<type_map<type_pair<Keys, Values>...>>::mask_words>
+    sparse_record<type_map<type_pair<Keys, Values>...>>::plane_masks;
+
+template <class Key, class M>
+auto get(const sparse_record<M>& r) {
+    return r.template get<Key>();
+}
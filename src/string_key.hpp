@@ -0,0 +1,142 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include "name_index.hpp"
+#include "type_map.hpp"
+
+template <char... Cs>
+struct string_key {
+    static constexpr char value[] = {Cs..., '\0'};
+    static constexpr uint64_t hash = fnv1a(const_string(value, sizeof...(Cs)));
+    static constexpr const_string str() { return const_string(value, sizeof...(Cs)); }
+};
+
+template <char... Cs>
+constexpr char string_key<Cs...>::value[];
+
+template <char... Cs>
+constexpr uint64_t string_key<Cs...>::hash;
+
+template <char... Cs>
+struct tag_name<string_key<Cs...>> {
+    static constexpr const_string get() { return string_key<Cs...>::str(); }
+};
+
+template <class T>
+struct is_string_key : std::false_type {};
+
+template <char... Cs>
+struct is_string_key<string_key<Cs...>> : std::true_type {};
+
+//==================================================================================================
+template <size_t n, char... Cs>
+struct string_key_prefix {
+    static_assert(n <= sizeof...(Cs), "string key is too long");
+    static constexpr char chars[] = {Cs...};
+
+    template <size_t... Is>
+    static string_key<chars[Is]...> make(std::index_sequence<Is...>);
+
+    using type = decltype(make(std::make_index_sequence<n>()));
+};
+
+template <size_t n, char... Cs>
+constexpr char string_key_prefix<n, Cs...>::chars[];
+
+template <size_t n, char... Cs>
+using string_key_prefix_t = is_type_t<string_key_prefix<n, Cs...>>;
+
+#define MINIMPL_KEY_CHAR(s, i) ((i) < sizeof(s) ? (s)[(i) < sizeof(s) ? (i) : 0] : '\0')
+#define MINIMPL_KEY_CHARS_4(s, i)                                                      \
+    MINIMPL_KEY_CHAR(s, i), MINIMPL_KEY_CHAR(s, i + 1), MINIMPL_KEY_CHAR(s, i + 2), \
+        MINIMPL_KEY_CHAR(s, i + 3)
+#define MINIMPL_KEY_CHARS_16(s, i)                                                           \
+    MINIMPL_KEY_CHARS_4(s, i), MINIMPL_KEY_CHARS_4(s, i + 4), MINIMPL_KEY_CHARS_4(s, i + 8), \
+        MINIMPL_KEY_CHARS_4(s, i + 12)
+#define MINIMPL_KEY_CHARS_64(s)                                                                  \
+    MINIMPL_KEY_CHARS_16(s, 0), MINIMPL_KEY_CHARS_16(s, 16), MINIMPL_KEY_CHARS_16(s, 32), \
+        MINIMPL_KEY_CHARS_16(s, 48)
+
+// C++14 spelling of a string key of at most 64 characters: MINIMPL_KEY("price")
+#define MINIMPL_KEY(s) string_key_prefix_t<sizeof(s) - 1, MINIMPL_KEY_CHARS_64(s)>
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+template <size_t n>
+struct fixed_string {
+    char data[n];
+
+    constexpr fixed_string(const char (&literal)[n]) {
+        for (size_t i = 0; i < n; i++) { data[i] = literal[i]; }
+    }
+};
+
+template <fixed_string s, size_t... Is>
+string_key<s.data[Is]...> make_string_key(std::index_sequence<Is...>);
+
+// C++20 spelling of a string key: key<"price">, the same type as MINIMPL_KEY("price")
+template <fixed_string s>
+using key = decltype(make_string_key<s>(std::make_index_sequence<sizeof(s.data) - 1>()));
+#endif
+
+//==================================================================================================
+template <class T>
+struct key_hash : std::integral_constant<uint64_t, 0> {};
+
+template <char... Cs>
+struct key_hash<string_key<Cs...>> : std::integral_constant<uint64_t, string_key<Cs...>::hash> {};
+
+template <class KeyList>
+struct key_hashes;
+
+template <class... Ks>
+struct key_hashes<type_list<Ks...>> {
+    static constexpr std::array<uint64_t, sizeof...(Ks)> value = {{key_hash<Ks>::value...}};
+
+    static constexpr size_t find(uint64_t hash) {
+        for (size_t i = 0; i < sizeof...(Ks); i++) {
+            if (value[i] == hash) { return i; }
+        }
+        return sizeof...(Ks);
+    }
+};
+
+template <class... Ks>
+constexpr std::array<uint64_t, sizeof...(Ks)> key_hashes<type_list<Ks...>>::value;
+
+template <class Key, size_t i, class... Ks>
+struct key_at : std::is_same<pack_element_t<i, Ks...>, Key> {};
+
+// string keys are looked up by comparing hashes, computed once per map, instead of types
+template <char... Cs, class... Ks>
+struct map_key_find<string_key<Cs...>, type_list<Ks...>>
+    : index_constant<key_hashes<type_list<Ks...>>::find(string_key<Cs...>::hash)> {
+    static_assert(std::conditional_t<(map_key_find::value < sizeof...(Ks)),
+                                     key_at<string_key<Cs...>, map_key_find::value, Ks...>,
+                                     std::true_type>::value,
+                  "string key hash collision");
+};
@@ -25,12 +25,43 @@ The fact that you are presently reading this means that you have had knowledge o
 license and that you accept its terms.*/
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_NO_POSIX_SIGNALS  // SIGSTKSZ is no longer a constant in recent glibc
 #include "doctest.h"
 
+#include <chrono>
+#include <set>
+#include <sstream>
+
+#include "aosoa_vector.hpp"
+#include "cold.hpp"
+#include "column_convert.hpp"
+#include "columnar_file.hpp"
+#include "compact_tuple.hpp"
+#include "compressed_column.hpp"
+#include "csv_reader.hpp"
+#include "fingerprint.hpp"
+#include "hot_cold_vector.hpp"
 #include "is_type.hpp"
+#include "json_writer.hpp"
+#include "layout.hpp"
+#include "layout_report.hpp"
+#include "map_migration.hpp"
+#include "name_index.hpp"
+#include "normalized_key.hpp"
+#include "packed_record.hpp"
+#include "record_view.hpp"
+#include "serialize.hpp"
+#include "soa_sort.hpp"
+#include "soa_vector.hpp"
+#include "sparse_record.hpp"
+#include "string_key.hpp"
+#include "type_id.hpp"
 #include "type_list.hpp"
 #include "type_map.hpp"
 #include "type_pair.hpp"
+#include "typed_record.hpp"
+#include "value_list.hpp"
+#include "value_map.hpp"
 
 TEST_CASE("is_type tests") {
     using T = is_type<double>;
@@ -113,4 +144,1248 @@ TEST_CASE("map tests") {
     CHECK(map_element_index<key1, m4>::value == 1);
     CHECK(map_element_index<key2, m4>::value == 2);
     CHECK(map_element_index<key4, m4>::value == 0);
-}
\ No newline at end of file
+}
+
+TEST_CASE("typed_record tests") {
+    struct key1 {};
+    struct key2 {};
+    struct key3 {};
+    using m = type_map<type_pair<key1, int>, type_pair<key2, double>, type_pair<key3, char>>;
+    struct hand_written {
+        int a;
+        double b;
+        char c;
+    };
+
+    typed_record<m> r{2, 3.5, 'c'};
+    CHECK(r.get<key1>() == 2);
+    CHECK(r.get<key2>() == 3.5);
+    CHECK(r.get<key3>() == 'c');
+    r.get<key1>() = 17;
+    get<key3>(r) = 'd';
+    CHECK(get<key1>(r) == 17);
+    CHECK(r.get<key3>() == 'd');
+
+    const typed_record<m> r2 = r;
+    CHECK(get<key2>(r2) == 3.5);
+    CHECK(get<0>(r2.data) == 17);
+
+    CHECK(sizeof(typed_record<m>) == sizeof(hand_written));
+    CHECK(std::is_trivially_copyable<typed_record<m>>::value);
+    CHECK(std::is_standard_layout<typed_record<m>>::value);
+    CHECK(sizeof(typed_record<type_map<type_pair<key1, int>>>) == sizeof(int));
+
+    // fields are laid out like the members of a flat struct
+    auto offset = [](const auto& record, const auto& field) {
+        return size_t(reinterpret_cast<const char*>(&field) -
+                      reinterpret_cast<const char*>(&record));
+    };
+    struct char_char_int {
+        char a;
+        char b;
+        int c;
+    };
+    typed_record<type_map<type_pair<key1, char>, type_pair<key2, char>, type_pair<key3, int>>>
+        cci{'a', 'b', 3};
+    CHECK(sizeof(cci) == sizeof(char_char_int));
+    CHECK(offset(cci, cci.get<key2>()) == offsetof(char_char_int, b));
+    CHECK(offset(cci, cci.get<key3>()) == offsetof(char_char_int, c));
+    struct char_short_char {
+        char a;
+        short b;
+        char c;
+    };
+    typed_record<type_map<type_pair<key1, char>, type_pair<key2, short>, type_pair<key3, char>>>
+        csc{'a', 2, 'c'};
+    CHECK(sizeof(csc) == sizeof(char_short_char));
+    CHECK(offset(csc, csc.get<key2>()) == offsetof(char_short_char, b));
+    CHECK(offset(csc, csc.get<key3>()) == offsetof(char_short_char, c));
+    CHECK(csc.get<key3>() == 'c');
+    CHECK(std::is_standard_layout<decltype(csc)>::value);
+
+    typed_record<m> array[4];
+    array[3].get<key2>() = 1.5;
+    CHECK(reinterpret_cast<char*>(&array[3]) - reinterpret_cast<char*>(&array[0]) ==
+          3 * sizeof(hand_written));
+
+    using m2 = type_map<type_pair<key1, std::string>, type_pair<key2, int>>;
+    typed_record<m2> r3{"hello", 2};
+    CHECK(r3.get<key1>() == "hello");
+    CHECK(not std::is_trivially_copyable<typed_record<m2>>::value);
+}
+
+TEST_CASE("compact_tuple tests") {
+    using l = type_list<char, double, char, int>;
+    CHECK(sizeof(std::tuple<char, double, char, int>) == 24);
+    CHECK(sizeof(compact_tuple<l>) == 16);
+    CHECK(std::is_same<compact_list_t<l>, type_list<double, int, char, char>>::value);
+    CHECK(alignment_order<l>::position(0) == 2);
+    CHECK(alignment_order<l>::position(1) == 0);
+    CHECK(alignment_order<l>::position(2) == 3);
+    CHECK(alignment_order<l>::position(3) == 1);
+    CHECK(std::is_trivially_copyable<compact_tuple<l>>::value);
+    CHECK(std::is_standard_layout<compact_tuple<l>>::value);
+
+    compact_tuple<l> t{'a', 2.5, 'b', 3};
+    CHECK(get<0>(t) == 'a');
+    CHECK(get<1>(t) == 2.5);
+    CHECK(get<2>(t) == 'b');
+    CHECK(get<3>(t) == 3);
+    get<2>(t) = 'z';
+    const compact_tuple<l> t2 = t;
+    CHECK(get<2>(t2) == 'z');
+    CHECK(std::is_same<decltype(get<3>(t2)), const int&>::value);
+
+    struct key1 {};
+    struct key2 {};
+    struct key3 {};
+    using m = type_map<type_pair<key1, char>, type_pair<key2, double>, type_pair<key3, char>>;
+    compact_record<m> r{'x', 1.5, 'y'};
+    CHECK(sizeof(r) == 16);
+    CHECK(sizeof(typed_record<m>) == 24);
+    CHECK(r.get<key1>() == 'x');
+    CHECK(r.get<key2>() == 1.5);
+    CHECK(get<key3>(r) == 'y');
+}
+
+struct throwing_copy {
+    bool fail{false};
+    throwing_copy() = default;
+    explicit throwing_copy(bool fail) : fail(fail) {}
+    throwing_copy(const throwing_copy& other) : fail(other.fail) {
+        if (fail) { throw std::runtime_error("copy"); }
+    }
+    throwing_copy(throwing_copy&&) = default;
+};
+
+struct limited_copy {  // copy-only, throws once constructions_left is exhausted, tracks instances
+    static int constructions_left;
+    static std::set<const limited_copy*> alive;
+    static int bad_destructions;
+    int value{1};
+    limited_copy() {
+        if (--constructions_left < 0) { throw std::runtime_error("construction"); }
+        alive.insert(this);
+    }
+    limited_copy(const limited_copy& other) : value(other.value) {
+        if (--constructions_left < 0) { throw std::runtime_error("copy"); }
+        alive.insert(this);
+    }
+    limited_copy& operator=(const limited_copy&) = default;
+    ~limited_copy() {
+        if (alive.erase(this) == 0) { bad_destructions++; }
+    }
+};
+int limited_copy::constructions_left = 0;
+std::set<const limited_copy*> limited_copy::alive;
+int limited_copy::bad_destructions = 0;
+
+TEST_CASE("soa_vector tests") {
+    struct key1 {};
+    struct key2 {};
+    struct key3 {};
+    using m =
+        type_map<type_pair<key1, int>, type_pair<key2, double>, type_pair<key3, std::string>>;
+
+    soa_vector<m> v;
+    CHECK(v.empty());
+    v.push_back(1, 1.5, "a");
+    v.push_back(typed_record<m>{2, 2.5, "b"});
+    v.push_back(compact_record<m>{3, 3.5, "c"});
+    CHECK(v.size() == 3);
+    CHECK(v.column<key1>().size() == 3);
+    CHECK(v.column<key3>()[1] == "b");
+
+    double sum = 0;
+    for (auto x : v.column<key2>()) { sum += x; }
+    CHECK(sum == 7.5);
+
+    v[1].get<key1>() = 12;
+    get<key3>(v[2]) = "z";
+    CHECK(v.column<key1>()[1] == 12);
+    CHECK(v.record(2).get<key3>() == "z");
+
+    v.reserve(1000);
+    CHECK(v.column<key3>()[0] == "a");
+    v.resize(10);
+    CHECK(v.size() == 10);
+    CHECK(v.column<key1>()[9] == 0);
+    CHECK(v.column<key2>()[2] == 3.5);
+    CHECK(reinterpret_cast<uintptr_t>(v.column<key1>().data()) % 64 == 0);
+    CHECK(reinterpret_cast<uintptr_t>(v.column<key2>().data()) % 64 == 0);
+
+    const soa_vector<m> v2 = v;
+    CHECK(v2[0].get<key3>() == "a");
+    CHECK(std::is_same<decltype(v2.column<key2>()[0]), const double&>::value);
+    v.clear();
+    CHECK(v.empty());
+    CHECK(v2.size() == 10);
+
+    // a throwing column leaves all columns with the same size
+    soa_vector<type_map<type_pair<key1, int>, type_pair<key2, throwing_copy>>> t;
+    t.push_back(1, throwing_copy());
+    CHECK_THROWS_AS(t.push_back(2, throwing_copy(true)), std::runtime_error);
+    CHECK(t.size() == 1);
+    size_t sizes = 0;
+    t.for_each_column([&](auto& column) { sizes += column.size(); });
+    CHECK(sizes == 2);
+
+    // a reallocation or copy that throws leaves the elements in place and leaks nothing
+    {
+        limited_copy::constructions_left = 100;
+        aligned_vector<limited_copy> copies;
+        for (int i = 0; i < 4; i++) { copies.push_back(limited_copy()); }
+        size_t capacity = copies.capacity();
+        limited_copy::constructions_left = 2;
+        CHECK_THROWS_AS(copies.reserve(100), std::runtime_error);
+        CHECK(copies.capacity() == capacity);
+        CHECK(copies.size() == 4);
+        CHECK(limited_copy::alive.size() == 4);
+        limited_copy::constructions_left = 2;
+        CHECK_THROWS_AS(aligned_vector<limited_copy>{copies}, std::runtime_error);
+        CHECK(limited_copy::alive.size() == 4);
+    }
+    CHECK(limited_copy::alive.empty());
+    CHECK(limited_copy::bad_destructions == 0);
+
+    // a throwing resize restores the previous size of all columns
+    {
+        soa_vector<type_map<type_pair<key1, int>, type_pair<key2, limited_copy>>> s;
+        limited_copy::constructions_left = 100;
+        s.resize(2);
+        limited_copy::constructions_left = 3;
+        CHECK_THROWS_AS(s.resize(10), std::runtime_error);
+        CHECK(s.size() == 2);
+        s.for_each_column([](auto& column) { CHECK(column.size() == 2); });
+        CHECK(limited_copy::alive.size() == 2);
+    }
+    CHECK(limited_copy::alive.empty());
+
+    aligned_vector<int> grown;
+    for (size_t i = 1; i <= 100; i++) { grown.resize(i); }
+    CHECK(grown.capacity() == 128);  // geometric growth
+}
+
+TEST_CASE("aosoa_vector tests") {
+    struct key1 {};
+    struct key2 {};
+    struct key3 {};
+    using m = type_map<type_pair<key1, float>, type_pair<key2, double>, type_pair<key3, char>>;
+
+    aosoa_vector<m, 8> v;
+    for (int i = 0; i < 20; i++) { v.push_back(float(i), 2.0 * i, char('a' + i)); }
+    v.push_back(typed_record<m>{20.f, 40.0, 'z'});
+    CHECK(v.size() == 21);
+    CHECK(v.block_count() == 3);
+    CHECK(v.get<key1>(9) == 9.f);
+    CHECK(v[20].get<key3>() == 'z');
+    v[3].get<key2>() = -1.0;
+    CHECK(v.get<key2>(3) == -1.0);
+
+    CHECK(alignof(block_column<float, 8>) == 32);
+    CHECK(alignof(block_column<double, 8>) == 64);
+    CHECK(alignof(block_column<char, 8>) == 8);
+
+    double total = 0;
+    size_t rows = 0;
+    v.for_each_block([&](auto block) {
+        const float* x = block.template get<key1>();
+        const double* y = get<key2>(block);
+        CHECK(reinterpret_cast<uintptr_t>(x) % 32 == 0);
+        CHECK(reinterpret_cast<uintptr_t>(y) % 64 == 0);
+        for (size_t i = 0; i < block.size; i++) { total += x[i] * y[i]; }
+        rows += block.size;
+    });
+    CHECK(rows == 21);
+    CHECK(v.block(2).size == 5);
+
+    v.resize(17);
+    CHECK(v.block_count() == 3);
+    v.resize(19);
+    CHECK(v.get<key1>(18) == 0.f);
+    CHECK(v.get<key1>(16) == 16.f);
+    v.clear();
+    CHECK(v.empty());
+}
+
+TEST_CASE("hot/cold tests") {
+    struct key1 {};
+    struct key2 {};
+    struct key3 {};
+    struct key4 {};
+    using m = type_map<type_pair<key1, double>, type_pair<key2, cold<std::string>>,
+                       type_pair<key3, int>, type_pair<key4, cold<double>>>;
+    CHECK(std::is_same<map_hot_t<m>,
+                       type_map<type_pair<key1, double>, type_pair<key3, int>>>::value);
+    CHECK(std::is_same<map_cold_t<m>, type_map<type_pair<key2, cold<std::string>>,
+                                                type_pair<key4, cold<double>>>>::value);
+    CHECK(std::is_same<list_filter_t<std::is_integral, type_list<int, double, char>>,
+                       type_list<int, char>>::value);
+
+    typed_record<m> r{1.5, "hello", 2, 3.5};
+    CHECK(r.get<key2>() == "hello");
+    CHECK(std::is_same<decltype(r.get<key4>()), double&>::value);
+
+    hot_cold_vector<m> v;
+    v.push_back(1.0, "a", 1, 10.0);
+    v.push_back(r);
+    CHECK(v.size() == 2);
+    CHECK(sizeof(hot_cold_vector<m>::hot_record) == 16);
+    CHECK(v.get<key1>(1) == 1.5);
+    CHECK(v.get<key2>(1) == "hello");
+    CHECK(v[0].get<key4>() == 10.0);
+    v[0].get<key2>() = "b";
+    CHECK(v.cold_records()[0].get<key2>() == "b");
+
+    double sum = 0;
+    for (auto& hot : v.hot_records()) { sum += hot.get<key1>() * hot.get<key3>(); }
+    CHECK(sum == 4.0);
+
+    v.resize(5);
+    CHECK(v.get<key3>(4) == 0);
+    CHECK(v.cold_records().size() == 5);
+
+    soa_vector<m> soa;
+    soa.push_back(1.0, "x", 2, 3.0);
+    CHECK(soa.column<key2>()[0] == "x");
+
+    hot_cold_vector<type_map<type_pair<key1, int>, type_pair<key2, cold<throwing_copy>>>> t;
+    CHECK_THROWS_AS(t.push_back(1, throwing_copy(true)), std::runtime_error);
+    CHECK(t.size() == 0);
+    CHECK(t.cold_records().size() == 0);
+}
+
+enum class color : uint8_t { red, green, blue };
+template <>
+struct bit_width<color> : std::integral_constant<size_t, 2> {};
+
+TEST_CASE("packed_record tests") {
+    struct flag1 {};
+    struct flag2 {};
+    struct flag3 {};
+    struct hue {};
+    struct small {};
+    using m = type_map<type_pair<flag1, bool>, type_pair<hue, color>, type_pair<flag2, bool>,
+                       type_pair<small, int8_t>, type_pair<flag3, bool>>;
+    CHECK(sizeof(packed_record<m>) == 2);
+    CHECK(packed_record<m>::word_count == 1);
+
+    packed_record<m> r;
+    CHECK(not r.get<flag1>());
+    CHECK(r.get<hue>() == color::red);
+    r.set<flag2>(true);
+    r.set<hue>(color::blue);
+    r.set<small>(-3);
+    CHECK(not r.get<flag1>());
+    CHECK(r.get<flag2>());
+    CHECK(not get<flag3>(r));
+    CHECK(r.get<hue>() == color::blue);
+    CHECK(r.get<small>() == -3);
+    r.set<small>(127);
+    r.set<flag2>(false);
+    CHECK(r.get<small>() == 127);
+    CHECK(not r.get<flag2>());
+    CHECK(r.get<hue>() == color::blue);
+
+    packed_record<m> r2{true, color::green, false, -128, true};
+    CHECK(r2.get<flag1>());
+    CHECK(r2.get<hue>() == color::green);
+    CHECK(r2.get<small>() == -128);
+    CHECK(r2.get<flag3>());
+
+    struct a {};
+    struct b {};
+    struct c {};
+    using m2 = type_map<type_pair<a, uint32_t>, type_pair<b, uint64_t>, type_pair<c, int32_t>>;
+    CHECK(packed_record<m2>::word_count == 2);
+    packed_record<m2> r3{4000000000u, 0xFFFFFFFFFFFFFFFFull, -7};
+    CHECK(r3.get<a>() == 4000000000u);
+    CHECK(r3.get<b>() == 0xFFFFFFFFFFFFFFFFull);
+    CHECK(r3.get<c>() == -7);
+}
+
+template <size_t i>
+using sparse_test_value =
+    std::conditional_t<i % 3 == 0, double, std::conditional_t<i % 3 == 1, char, int>>;
+
+template <size_t... Is>
+type_map<type_pair<index_constant<Is>, sparse_test_value<Is>>...> sparse_test_map(
+    std::index_sequence<Is...>);
+
+TEST_CASE("sparse_record tests") {
+    using m = decltype(sparse_test_map(std::make_index_sequence<80>()));
+    using r_t = sparse_record<m>;
+    CHECK(r_t::mask_words == 2);
+    CHECK(sizeof(r_t) == 2 * sizeof(uint64_t) + sizeof(void*));
+
+    r_t r;
+    CHECK(r.byte_size() == 0);
+    CHECK(not r.has<index_constant<5>>());
+    CHECK(r.get<index_constant<5>>() == 0);
+
+    r.set<index_constant<71>>(3);     // int
+    r.set<index_constant<3>>(1.5);    // double
+    r.set<index_constant<64>>('x');   // char
+    r.set<index_constant<40>>('y');   // char
+    r.set<index_constant<78>>(2.25);  // double
+    CHECK(r.byte_size() == 4 + 8 + 1 + 1 + 8);
+    CHECK(r.has<index_constant<71>>());
+    CHECK(r.get<index_constant<71>>() == 3);
+    CHECK(r.get<index_constant<3>>() == 1.5);
+    CHECK(r.get<index_constant<64>>() == 'x');
+    CHECK(get<index_constant<40>>(r) == 'y');
+    CHECK(r.get<index_constant<78>>() == 2.25);
+
+    r.set<index_constant<71>>(-4);
+    CHECK(r.byte_size() == 22);
+    CHECK(r.get<index_constant<71>>() == -4);
+
+    r_t copy = r;
+    r.reset<index_constant<64>>();
+    CHECK(not r.has<index_constant<64>>());
+    CHECK(r.get<index_constant<71>>() == -4);
+    CHECK(r.get<index_constant<78>>() == 2.25);
+    CHECK(r.byte_size() == 21);
+    CHECK(copy.get<index_constant<64>>() == 'x');
+    CHECK(copy.byte_size() == 22);
+
+    r_t moved(std::move(copy));
+    CHECK(moved.get<index_constant<64>>() == 'x');
+    CHECK(not copy.has<index_constant<64>>());
+    CHECK(copy.byte_size() == 0);
+    copy.set<index_constant<3>>(0.5);
+    CHECK(copy.get<index_constant<3>>() == 0.5);
+    r_t reused = copy;
+    CHECK(reused.get<index_constant<3>>() == 0.5);
+    r = std::move(moved);
+    CHECK(moved.byte_size() == 0);
+    CHECK(r.get<index_constant<64>>() == 'x');
+    moved.set<index_constant<71>>(5);
+    CHECK(moved.get<index_constant<71>>() == 5);
+}
+
+namespace type_id_test {
+    struct foo {};
+    template <class T>
+    struct bar {};
+}  // namespace type_id_test
+
+TEST_CASE("type_id tests") {
+    constexpr const_string name = type_name<int>();
+    static_assert(name == "int", "");
+    CHECK(type_name<int>() == "int");
+    CHECK(type_name<type_id_test::foo>() == "type_id_test::foo");
+    CHECK(type_name<type_id_test::bar<double>>() == "type_id_test::bar<double>");
+    CHECK(type_name<const char*>().str() == "const char*");
+
+    constexpr uint64_t id = type_id<double>();
+    static_assert(id == fnv1a("double"), "");
+    CHECK(type_id<int>() != type_id<unsigned>());
+    CHECK(type_id<type_id_test::bar<int>>() != type_id<type_id_test::bar<char>>());
+
+    using l = type_list<int, double, type_id_test::foo>;
+    CHECK(list_type_ids<l>::value.size() == 3);
+    CHECK(list_type_ids<l>::value[1] == type_id<double>());
+    CHECK(list_type_ids<l>::value[2] == fnv1a("type_id_test::foo"));
+
+    CHECK(const_string("abcabd").find("abd") == 3);
+    CHECK(const_string("abc").find("x") == 3);
+    CHECK(const_string("hello").substr(1, 3) == "el");
+}
+
+namespace name_index_test {
+    struct position {};
+    struct velocity {};
+    struct mass {};
+    struct charge {};
+}  // namespace name_index_test
+
+template <>
+struct tag_name<name_index_test::charge> {
+    static constexpr const_string get() { return "q"; }
+};
+
+TEST_CASE("list_name_index tests") {
+    using namespace name_index_test;
+    using l = type_list<position, velocity, mass, charge, int, double, char, long>;
+    using index = list_name_index<l>;
+    CHECK(index::find("name_index_test::position") == 0);
+    CHECK(index::find("name_index_test::velocity") == 1);
+    CHECK(index::find("name_index_test::mass") == 2);
+    CHECK(index::find("q") == 3);
+    CHECK(index::find(std::string("double")) == 5);
+    CHECK(index::find(type_name<long>()) == 7);
+    CHECK(index::find("name_index_test::charge") == 8);
+    CHECK(index::find("") == 8);
+    CHECK(list_name_index<type_list<>>::find("int") == 0);
+
+    for (size_t i = 0; i < list_size<l>::value; i++) {
+        CHECK(index::find(index::names[i]) == i);
+    }
+
+    auto size_of_type = [](auto t) { return sizeof(is_type_t<decltype(t)>); };
+    CHECK(list_visit<l>(index::find("double"), size_of_type) == sizeof(double));
+    std::string name;
+    list_visit<l>(index::find("q"),
+                  [&](auto t) { name = type_name<is_type_t<decltype(t)>>().str(); });
+    CHECK(name == "name_index_test::charge");
+    CHECK_THROWS_AS(list_visit<l>(index::find("unknown"), size_of_type), std::out_of_range);
+}
+
+template <size_t i>
+using numbered_key =
+    string_key<'k', char('0' + i / 100), char('0' + i / 10 % 10), char('0' + i % 10)>;
+
+template <size_t... Is>
+type_map<type_pair<numbered_key<Is>, index_constant<Is>>...> numbered_map(
+    std::index_sequence<Is...>);
+
+TEST_CASE("string_key tests") {
+    using price = MINIMPL_KEY("price");
+    CHECK(std::is_same<price, string_key<'p', 'r', 'i', 'c', 'e'>>::value);
+    CHECK(std::is_same<MINIMPL_KEY(""), string_key<>>::value);
+    CHECK(price::str() == "price");
+    CHECK(price::hash == fnv1a("price"));
+    CHECK(is_string_key<price>::value);
+    CHECK(not is_string_key<int>::value);
+
+    struct other {};
+    using m = type_map<type_pair<MINIMPL_KEY("id"), int>, type_pair<other, char>,
+                       type_pair<price, double>, type_pair<MINIMPL_KEY("name"), std::string>>;
+    CHECK(std::is_same<map_element_t<price, m>, double>::value);
+    CHECK(std::is_same<map_element_t<MINIMPL_KEY("name"), m>, std::string>::value);
+    CHECK(std::is_same<map_element_t<other, m>, char>::value);
+    CHECK(map_element_index<MINIMPL_KEY("id"), m>::value == 0);
+    CHECK(map_element_index<price, m>::value == 2);
+
+    typed_record<m> r{1, 'c', 2.5, "x"};
+    CHECK(r.get<MINIMPL_KEY("price")>() == 2.5);
+    CHECK(list_name_index<map_key_list_t<m>>::find("name") == 3);
+
+    using big = decltype(numbered_map(std::make_index_sequence<1000>()));
+    CHECK(map_element_t<numbered_key<0>, big>::value == 0);
+    CHECK(map_element_t<numbered_key<517>, big>::value == 517);
+    CHECK(map_element_t<MINIMPL_KEY("k999"), big>::value == 999);
+    CHECK(map_element_index<numbered_key<998>, big>::value == 998);
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+    CHECK(std::is_same<key<"price">, price>::value);
+#endif
+}
+
+enum class opcode { load = 2, store, add, jump = 7 };
+
+TEST_CASE("value_map tests") {
+    struct load_handler {};
+    struct store_handler {};
+    using m = value_map<value_pair<opcode, opcode::store, store_handler>,
+                        value_pair<opcode, opcode::load, load_handler>,
+                        value_pair<opcode, opcode::add, int>,
+                        value_pair<opcode, opcode::jump, double>>;
+    CHECK(std::is_same<map_element_t<value_key<opcode, opcode::load>, m>, load_handler>::value);
+    CHECK(std::is_same<map_element_t<value_key<opcode, opcode::jump>, m>, double>::value);
+    CHECK(map_element_index<value_key<opcode, opcode::add>, m>::value == 2);
+    CHECK(value_map_slots<m>::dense);
+    CHECK(value_map_slots<m>::min == 2);
+    CHECK(value_map_slots<m>::range == 6);
+
+    CHECK(value_map_find<m>(opcode::store) == 0);
+    CHECK(value_map_find<m>(opcode::jump) == 3);
+    CHECK(value_map_find<m>(static_cast<opcode>(5)) == 4);
+    CHECK(value_map_find<m>(static_cast<opcode>(100)) == 4);
+
+    auto size = [](auto t) { return sizeof(is_type_t<decltype(t)>); };
+    CHECK(value_map_visit<m>(opcode::jump, size) == sizeof(double));
+    CHECK(value_map_visit<m>(opcode::add, size) == sizeof(int));
+    CHECK_THROWS_AS(value_map_visit<m>(static_cast<opcode>(5), size), std::out_of_range);
+    CHECK(value_map_visit<m>(static_cast<opcode>(100), size, [] { return size_t(0); }) == 0);
+    CHECK(value_map_visit<m>(opcode::jump, size, [] { return size_t(0); }) == sizeof(double));
+
+    using sizes = value_map_to_value<size_of, size_t, m>;
+    CHECK(sizes::value.size() == 6);
+    CHECK(sizes::at(opcode::add) == sizeof(int));
+    CHECK(sizes::at(opcode::jump) == sizeof(double));
+    CHECK(sizes::at(static_cast<opcode>(6)) == 0);
+    CHECK(sizes::at(static_cast<opcode>(0)) == 0);
+    CHECK(sizes::at(static_cast<opcode>(100)) == 0);
+
+    using sparse =
+        type_map<type_pair<value_key<int, 0>, char>, type_pair<value_key<int, 1000>, int>>;
+    CHECK(not value_map_slots<sparse>::dense);
+    CHECK(std::is_same<map_element_t<value_key<int, 1000>, sparse>, int>::value);
+    CHECK(value_map_find<sparse>(1000) == 1);
+
+    // plain integral_constant keys keep the lookup of type_map
+    using indexed = type_map<type_pair<index_constant<1>, int>, type_pair<index_constant<0>, char>>;
+    CHECK(map_element_index<index_constant<0>, indexed>::value == 1);
+    CHECK(not std::is_same<value_key<int, 1>, std::integral_constant<int, 1>>::value);
+}
+
+struct times_ten {
+    constexpr size_t operator()(size_t x) const { return 10 * x; }
+};
+
+TEST_CASE("value_list tests") {
+    using l = index_list<3, 1, 4, 1, 5, 9, 2, 6>;
+    CHECK(is_value_list<l>::value);
+    CHECK(not is_value_list<type_list<int>>::value);
+    CHECK(l::size == 8);
+    CHECK(l::value[2] == 4);
+    CHECK(value_list_find<l, 1>::value == 1);
+    CHECK(value_list_find<l, 7>::value == 8);
+    CHECK(value_list_contains<l, 9>::value);
+    CHECK(not value_list_contains<l, 8>::value);
+
+    CHECK(std::is_same<value_list_map_t<times_ten, index_list<1, 2>>, index_list<10, 20>>::value);
+    CHECK(value_list_sum<l>::value == 31);
+    CHECK(value_list_reduce<std::multiplies<size_t>, index_list<2, 3, 4>, 1>::value == 24);
+
+    CHECK(std::is_same<value_list_sort_t<l>, index_list<1, 1, 2, 3, 4, 5, 6, 9>>::value);
+    CHECK(std::is_same<value_list_sort_t<l, std::greater<size_t>>,
+                       index_list<9, 6, 5, 4, 3, 2, 1, 1>>::value);
+    CHECK(std::is_same<value_list_sort_t<index_list<>>, index_list<>>::value);
+
+    CHECK(std::is_same<value_list_concat_t<index_list<1>, index_list<>, index_list<2, 3>>,
+                       index_list<1, 2, 3>>::value);
+    CHECK(std::is_same<value_list_slice_t<2, 5, l>, index_list<4, 1, 5>>::value);
+    CHECK(std::is_same<value_list_slice_t<8, 8, l>, index_list<>>::value);
+
+    CHECK(std::is_same<value_list_to_sequence_t<index_list<0, 1, 2>>,
+                       std::make_index_sequence<3>>::value);
+    CHECK(std::is_same<value_list_from_sequence_t<int, std::make_index_sequence<3>>,
+                       value_list<int, 0, 1, 2>>::value);
+
+    using big = value_list_from_sequence_t<size_t, std::make_index_sequence<2000>>;
+    using reversed = value_list_sort_t<big, std::greater<size_t>>;
+    CHECK(reversed::value[0] == 1999);
+    CHECK(reversed::value[1999] == 0);
+}
+
+TEST_CASE("layout tests") {
+    using l = type_list<char, double, char, int>;
+    struct s {
+        char a;
+        double b;
+        char c;
+        int d;
+    };
+    CHECK(list_offsets<l>::value[0] == offsetof(s, a));
+    CHECK(list_offsets<l>::value[1] == offsetof(s, b));
+    CHECK(list_offsets<l>::value[2] == offsetof(s, c));
+    CHECK(list_offsets<l>::value[3] == offsetof(s, d));
+    CHECK(list_layout_size<l>::value == sizeof(s));
+    CHECK(list_layout_align<l>::value == alignof(s));
+    CHECK(list_layout_padding<l>::value == 10);
+
+    CHECK(list_compact_offsets<l>::value[0] == 12);
+    CHECK(list_compact_offsets<l>::value[1] == 0);
+    CHECK(list_compact_offsets<l>::value[2] == 13);
+    CHECK(list_compact_offsets<l>::value[3] == 8);
+    CHECK(list_compact_layout_size<l>::value == sizeof(compact_tuple<l>));
+    CHECK(list_padding_saved<l>::value == 8);
+
+    using l2 = type_list<short, char>;
+    CHECK(list_layout_size<l2>::value == 4);
+    CHECK(list_layout_size<type_list<>>::value == 0);
+    CHECK(list_padding_saved<type_list<int, int>>::value == 0);
+}
+
+TEST_CASE("layout_report tests") {
+    using registry = type_map<
+        type_pair<MINIMPL_KEY("point"), type_map<type_pair<MINIMPL_KEY("tag"), char>,
+                                                 type_pair<MINIMPL_KEY("x"), double>>>,
+        type_pair<MINIMPL_KEY("pair"), type_list<short, short>>>;
+    std::stringstream ss;
+    layout_report<registry>::write(ss);
+    std::string point, pair;
+    std::getline(ss, point);
+    std::getline(ss, pair);
+    CHECK(point ==
+          "{\"schema\":\"point\",\"align\":8,"
+          "\"declared\":{\"size\":16,\"padding\":7,\"fields\":["
+          "{\"name\":\"tag\",\"type\":\"char\",\"offset\":0,"
+          "\"size\":1,\"align\":1,\"padding\":7},"
+          "{\"name\":\"x\",\"type\":\"double\",\"offset\":8,"
+          "\"size\":8,\"align\":8,\"padding\":0}]},"
+          "\"compact\":{\"size\":16,\"padding\":7,\"fields\":["
+          "{\"name\":\"x\",\"type\":\"double\",\"offset\":0,"
+          "\"size\":8,\"align\":8,\"padding\":0},"
+          "{\"name\":\"tag\",\"type\":\"char\",\"offset\":8,"
+          "\"size\":1,\"align\":1,\"padding\":7}]},"
+          "\"padding_saved\":0}");
+    CHECK(pair.find("\"fields\":[{\"name\":\"0\",\"type\":\"short int\"") !=
+          std::string::npos);
+    CHECK(layout_report<registry>::max_padding() == 7);
+    CHECK(layout_report<type_map<>>::max_padding() == 0);
+}
+
+TEST_CASE("record_view tests") {
+    using m = type_map<type_pair<MINIMPL_KEY("side"), char>, type_pair<MINIMPL_KEY("flag"), char>,
+                       type_pair<MINIMPL_KEY("quantity"), int>,
+                       type_pair<MINIMPL_KEY("price"), double>>;
+    typed_record<m> records[2] = {{'b', 'x', 10, 1.5}, {'s', 'y', 20, 2.5}};
+    record_view<m> view(records);
+    CHECK(record_view<m>::size == sizeof(typed_record<m>));
+    CHECK(view.get<MINIMPL_KEY("side")>() == 'b');
+    CHECK(view.get<MINIMPL_KEY("flag")>() == 'x');
+    CHECK(view.get<MINIMPL_KEY("quantity")>() == 10);
+    CHECK(get<MINIMPL_KEY("price")>(view) == 1.5);
+    CHECK(view.at(1).get<MINIMPL_KEY("quantity")>() == 20);
+
+    mutable_record_view<m> mut(records);
+    mut.at(1).set<MINIMPL_KEY("price")>(3.5);
+    CHECK(records[1].get<MINIMPL_KEY("price")>() == 3.5);
+
+    compact_record<m> compact{'s', 'z', 30, 4.5};
+    record_view<m, compact_layout> compact_view(&compact);
+    CHECK(compact_view.get<MINIMPL_KEY("side")>() == 's');
+    CHECK(compact_view.get<MINIMPL_KEY("flag")>() == 'z');
+    CHECK(compact_view.get<MINIMPL_KEY("quantity")>() == 30);
+
+    // cold fields are stored as their value type
+    using cold_m = type_map<type_pair<MINIMPL_KEY("side"), char>,
+                            type_pair<MINIMPL_KEY("price"), cold<double>>,
+                            type_pair<MINIMPL_KEY("quantity"), int>>;
+    typed_record<cold_m> cold_record{'b', 2.5, 7};
+    record_view<cold_m> cold_view(&cold_record);
+    CHECK(record_view<cold_m>::size == sizeof(typed_record<cold_m>));
+    CHECK(cold_view.get<MINIMPL_KEY("price")>() == 2.5);
+    CHECK(cold_view.get<MINIMPL_KEY("quantity")>() == 7);
+
+    // unaligned big-endian buffer
+    unsigned char bytes[] = {0xff, 0, 1, 0, 2, 0x12, 0x34};
+    using m2 = type_map<type_pair<int, int32_t>, type_pair<short, int16_t>>;
+    using be_view = record_view<m2, declared_layout, byte_order::big>;
+    be_view be(bytes + 1);
+    CHECK(be.get<int>() == 0x00010002);
+    CHECK(be.get<short>() == 0x1234);
+    mutable_record_view<m2, declared_layout, byte_order::big>(bytes + 1).set<short>(0x5678);
+    CHECK(bytes[5] == 0x56);
+    CHECK(bytes[6] == 0x78);
+    CHECK(byteswap(uint32_t(0x01020304)) == 0x04030201);
+
+    // fixed-size strings are not byte-swapped
+    using m3 = type_map<type_pair<MINIMPL_KEY("code"), std::array<char, 4>>,
+                        type_pair<MINIMPL_KEY("count"), uint16_t>>;
+    unsigned char code_bytes[] = {'A', 'B', 'C', 'D', 0x01, 0x02};
+    record_view<m3, declared_layout, byte_order::big> code_view(code_bytes);
+    CHECK(code_view.get<MINIMPL_KEY("code")>() == (std::array<char, 4>{{'A', 'B', 'C', 'D'}}));
+    CHECK(code_view.get<MINIMPL_KEY("count")>() == 0x0102);
+    mutable_record_view<m3, declared_layout, byte_order::big>(code_bytes)
+        .set<MINIMPL_KEY("code")>({{'W', 'X', 'Y', 'Z'}});
+    CHECK(code_bytes[0] == 'W');
+    CHECK(code_bytes[3] == 'Z');
+}
+
+TEST_CASE("columnar_file tests") {
+    using m = type_map<type_pair<MINIMPL_KEY("id"), int>, type_pair<MINIMPL_KEY("price"), double>,
+                       type_pair<MINIMPL_KEY("side"), char>>;
+    soa_vector<m> v;
+    for (int i = 0; i < 100; i++) { v.push_back(i, i * 0.5, i % 2 ? 'b' : 's'); }
+    const std::string path = "columnar_file_test.bin";
+    write_columnar(path, v);
+    {
+        columnar_file<m> file(path);
+        REQUIRE(file.size() == 100);
+        auto prices = file.column<MINIMPL_KEY("price")>();
+        CHECK(reinterpret_cast<uintptr_t>(prices.data()) % columnar_alignment == 0);
+        CHECK(prices[99] == 49.5);
+        CHECK(file.get<MINIMPL_KEY("id")>(42) == 42);
+        CHECK(file.column<MINIMPL_KEY("side")>()[3] == 'b');
+
+        using other = type_map<type_pair<MINIMPL_KEY("id"), int>,
+                               type_pair<MINIMPL_KEY("price"), float>,
+                               type_pair<MINIMPL_KEY("side"), char>>;
+        CHECK_THROWS_AS(columnar_file<other>{path}, std::runtime_error);
+    }
+    write_columnar(path, soa_vector<m>());
+    CHECK(columnar_file<m>(path).empty());
+    std::remove(path.c_str());
+    CHECK_THROWS_AS(columnar_file<m>{path}, std::runtime_error);
+}
+
+TEST_CASE("fingerprint tests") {
+    using l = type_list<int, double>;
+    static_assert(list_fingerprint<l>::value == list_fingerprint<std::tuple<int, double>>::value,
+                  "");
+    CHECK(list_fingerprint<l>::value != list_fingerprint<type_list<double, int>>::value);
+    CHECK(list_fingerprint<l>::value != list_fingerprint<type_list<int, double, int>>::value);
+    CHECK(list_fingerprint<type_list<>>::value != list_fingerprint<type_list<int>>::value);
+
+    using m = type_map<type_pair<MINIMPL_KEY("id"), int>, type_pair<MINIMPL_KEY("price"), double>>;
+    using renamed =
+        type_map<type_pair<MINIMPL_KEY("id"), int>, type_pair<MINIMPL_KEY("cost"), double>>;
+    using retyped =
+        type_map<type_pair<MINIMPL_KEY("id"), int>, type_pair<MINIMPL_KEY("price"), float>>;
+    constexpr uint64_t f = map_fingerprint<m>::value;
+    CHECK(f != map_fingerprint<renamed>::value);
+    CHECK(f != map_fingerprint<retyped>::value);
+    CHECK(f != list_fingerprint<l>::value);
+
+    // cold values are stored like the others
+    using cold_price =
+        type_map<type_pair<MINIMPL_KEY("id"), int>, type_pair<MINIMPL_KEY("price"), cold<double>>>;
+    CHECK(map_fingerprint<cold_price>::value == f);
+}
+
+TEST_CASE("map_migration tests") {
+    using id = MINIMPL_KEY("id");
+    using price = MINIMPL_KEY("price");
+    using side = MINIMPL_KEY("side");
+    using volume = MINIMPL_KEY("volume");
+    using v1 = type_map<type_pair<id, int>, type_pair<side, char>, type_pair<price, float>>;
+    using v2 = type_map<type_pair<price, double>, type_pair<id, int>, type_pair<volume, long>>;
+    using migration = map_migration<v1, v2>;
+    CHECK(std::is_same<migration::kept, type_list<price, id>>::value);
+    CHECK(std::is_same<migration::dropped, type_list<side>>::value);
+    CHECK(std::is_same<migration::added, type_list<volume>>::value);
+    CHECK(std::is_same<migration::copied, type_list<id>>::value);
+    CHECK(key_migration_of<price, v1, v2>::value == key_migration::convert);
+
+    soa_vector<v1> old;
+    for (int i = 0; i < 10; i++) { old.push_back(i, 'b', i * 0.5f); }
+    soa_vector<v2> upgraded = migration::migrate(old);
+    REQUIRE(upgraded.size() == 10);
+    CHECK(upgraded.get<id>(7) == 7);
+    CHECK(upgraded.get<price>(7) == 3.5);
+    CHECK(upgraded.get<volume>(7) == 0);
+
+    std::vector<typed_record<v1>> records = {{1, 's', 1.5f}, {2, 'b', 2.5f}};
+    auto upgraded_records = migration::migrate(records);
+    REQUIRE(upgraded_records.size() == 2);
+    CHECK(upgraded_records[1].get<id>() == 2);
+    CHECK(upgraded_records[1].get<price>() == 2.5);
+    CHECK(upgraded_records[1].get<volume>() == 0);
+}
+
+enum class csv_side : char { buy, sell };
+
+template <>
+struct field_parser<csv_side> {
+    static bool parse(const char* begin, const char* end, csv_side& out) {
+        out = *begin == 'b' ? csv_side::buy : csv_side::sell;
+        return end - begin == 1 and (*begin == 'b' or *begin == 's');
+    }
+};
+
+TEST_CASE("csv_reader tests") {
+    using m = type_map<type_pair<MINIMPL_KEY("id"), unsigned>, type_pair<MINIMPL_KEY("delta"), int>,
+                       type_pair<MINIMPL_KEY("price"), double>,
+                       type_pair<MINIMPL_KEY("symbol"), std::array<char, 4>>,
+                       type_pair<MINIMPL_KEY("side"), csv_side>,
+                       type_pair<MINIMPL_KEY("active"), bool>>;
+    std::stringstream in(
+        "id,delta,price,symbol,side,active\r\n"
+        "1,-5,10.25,ABC,b,true\r\n"
+        "\n"
+        "2,+7,1e3,ABCDEF,s,0\n"
+        "3,0,-0.5,,b,1");
+    soa_vector<m> v;
+    CHECK(read_csv(in, v, csv_options(',', true)) == 3);
+    REQUIRE(v.size() == 3);
+    CHECK(v.get<MINIMPL_KEY("id")>(2) == 3);
+    CHECK(v.get<MINIMPL_KEY("delta")>(0) == -5);
+    CHECK(v.get<MINIMPL_KEY("delta")>(1) == 7);
+    CHECK(v.get<MINIMPL_KEY("price")>(0) == 10.25);
+    CHECK(v.get<MINIMPL_KEY("price")>(1) == 1000);
+    CHECK(std::string(v.get<MINIMPL_KEY("symbol")>(0).data(), 3) == "ABC");
+    CHECK(v.get<MINIMPL_KEY("symbol")>(0)[3] == '\0');
+    CHECK(std::string(v.get<MINIMPL_KEY("symbol")>(1).data(), 4) == "ABCD");
+    CHECK(v.get<MINIMPL_KEY("side")>(1) == csv_side::sell);
+    CHECK(v.get<MINIMPL_KEY("active")>(0));
+    CHECK(not v.get<MINIMPL_KEY("active")>(1));
+
+    // tiny blocks force lines to be split across reads
+    using m2 = type_map<type_pair<int, int>, type_pair<double, double>>;
+    std::string tsv;
+    for (int i = 0; i < 1000; i++) { tsv += std::to_string(i) + "\t" + std::to_string(i) + ".5\n"; }
+    std::stringstream tsv_in(tsv);
+    soa_vector<m2> v2;
+    CHECK(csv_reader<m2>(csv_options('\t')).read(tsv_in, v2, 8) == 1000);
+    CHECK(v2.get<int>(999) == 999);
+    CHECK(v2.get<double>(123) == 123.5);
+
+    std::stringstream bad("1\t2\t3\n");
+    CHECK_THROWS_AS(read_csv(bad, v2, csv_options('\t')), std::runtime_error);
+    std::stringstream bad_value("1\tx\n");
+    CHECK_THROWS_AS(read_csv(bad_value, v2, csv_options('\t')), std::runtime_error);
+    CHECK(v2.size() == 1000);
+    std::stringstream bad_middle("5\t6\n7\tx\n8\t9\n");
+    CHECK_THROWS_AS(read_csv(bad_middle, v2, csv_options('\t')), std::runtime_error);
+    REQUIRE(v2.size() == 1001);
+    CHECK(v2.get<int>(1000) == 5);
+    CHECK(v2.get<double>(1000) == 6);
+
+    // integers out of range are rejected
+    uint8_t u8;
+    int8_t i8;
+    int64_t i64;
+    CHECK(field_parser<uint8_t>::parse("255", "255" + 3, u8));
+    CHECK(not field_parser<uint8_t>::parse("300", "300" + 3, u8));
+    CHECK(not field_parser<uint8_t>::parse("256", "256" + 3, u8));
+    CHECK(field_parser<int8_t>::parse("-128", "-128" + 4, i8));
+    CHECK(i8 == -128);
+    CHECK(not field_parser<int8_t>::parse("128", "128" + 3, i8));
+    const char* min64 = "-9223372036854775808";
+    CHECK(field_parser<int64_t>::parse(min64, min64 + 20, i64));
+    CHECK(i64 == std::numeric_limits<int64_t>::min());
+    CHECK(not field_parser<int64_t>::parse(min64 + 1, min64 + 20, i64));
+    std::stringstream overflow("1\t300\n");
+    soa_vector<type_map<type_pair<int, int>, type_pair<uint8_t, uint8_t>>> small;
+    CHECK_THROWS_AS(read_csv(overflow, small, csv_options('\t')), std::runtime_error);
+
+    // the decimal fast path agrees with strtod
+    for (const char* x : {"0.1", "-2.5", "123456.789", "1.", ".5", "999999999999999", "0.3e1",
+                          "1234567890123456789", "-0"}) {
+        double d;
+        CHECK(field_parser<double>::parse(x, x + std::strlen(x), d));
+        CHECK(d == std::strtod(x, nullptr));
+    }
+
+    // throughput per byte does not degrade with the input size (or the number of blocks)
+    auto seconds_per_byte = [](size_t bytes) {
+        std::string text;
+        while (text.size() < bytes) { text += "12345,1.25,-987654321\n"; }
+        double best = 1e9;
+        for (int run = 0; run < 3; run++) {
+            std::istringstream text_in(text);
+            soa_vector<type_map<type_pair<int, int>, type_pair<double, double>,
+                                type_pair<long, int64_t>>> rows;
+            auto start = std::chrono::steady_clock::now();
+            csv_reader<decltype(rows)::map>().read(text_in, rows, size_t(1) << 16);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count());
+        }
+        return best / double(text.size());
+    };
+    CHECK(seconds_per_byte(size_t(16) << 20) < 4 * seconds_per_byte(size_t(1) << 20));
+}
+
+TEST_CASE("serialize tests") {
+    using id = MINIMPL_KEY("id");
+    using flag = MINIMPL_KEY("flag");
+    using name = MINIMPL_KEY("name");
+    using price = MINIMPL_KEY("price");
+    using history = MINIMPL_KEY("history");
+    using m = type_map<type_pair<id, int>, type_pair<flag, char>, type_pair<name, std::string>,
+                       type_pair<price, double>, type_pair<history, std::vector<float>>>;
+    CHECK(encoding_of(std::array<bool, 5>{{true, true, false, true, false}}, 1) ==
+          field_encoding::in_run);
+
+    typed_record<m> r(7, 'x', "seven", 7.5, {1.f, 2.f});
+    std::vector<char> bytes;
+    serialize(r, bytes);
+    CHECK(bytes.size() == serialized_size(r));
+    // int and char share a memcpy, padding between them included
+    size_t run = size_t(reinterpret_cast<const char*>(&r.get<flag>() + 1) -
+                        reinterpret_cast<const char*>(&r.get<id>()));
+    CHECK(bytes.size() == run + (8 + 5) + 8 + (8 + 8));
+
+    typed_record<m> copy;
+    CHECK(deserialize(bytes.data(), bytes.data() + bytes.size(), copy) ==
+          bytes.data() + bytes.size());
+    CHECK(copy.get<id>() == 7);
+    CHECK(copy.get<flag>() == 'x');
+    CHECK(copy.get<name>() == "seven");
+    CHECK(copy.get<price>() == 7.5);
+    CHECK(copy.get<history>() == std::vector<float>{1.f, 2.f});
+    CHECK_THROWS_AS(deserialize(bytes.data(), bytes.data() + bytes.size() - 1, copy),
+                    std::runtime_error);
+
+    std::vector<compact_record<m>> batch = {{1, 'a', "one", 1.5, {}}, {2, 'b', "", 2.5, {3.f}}};
+    std::vector<char> batch_bytes;
+    serialize(batch, batch_bytes);
+    std::vector<compact_record<m>> decoded;
+    deserialize(batch_bytes.data(), batch_bytes.data() + batch_bytes.size(), decoded);
+    REQUIRE(decoded.size() == 2);
+    CHECK(decoded[0].get<name>() == "one");
+    CHECK(decoded[1].get<id>() == 2);
+    CHECK(decoded[1].get<history>() == std::vector<float>{3.f});
+
+    // the padding of a run does not leak into the encoding
+    using padded = type_map<type_pair<flag, char>, type_pair<id, int>, type_pair<price, double>>;
+    typed_record<padded> a{'a', 1, 1.5}, b;
+    std::memset(static_cast<void*>(&b), 0xff, sizeof(b));
+    b.get<flag>() = 'a';
+    b.get<id>() = 1;
+    b.get<price>() = 1.5;
+    std::vector<char> a_bytes, b_bytes;
+    serialize(a, a_bytes);
+    serialize(b, b_bytes);
+    CHECK(a_bytes.size() == sizeof(a));
+    CHECK(a_bytes == b_bytes);
+    CHECK(b_bytes[1] == 0);
+}
+
+TEST_CASE("json_writer tests") {
+    using m = type_map<type_pair<MINIMPL_KEY("id"), int64_t>,
+                       type_pair<MINIMPL_KEY("price"), double>,
+                       type_pair<MINIMPL_KEY("name"), std::string>, type_pair<bool, bool>,
+                       type_pair<MINIMPL_KEY("code"), std::array<char, 4>>>;
+    json_writer writer;
+    writer.write(
+        typed_record<m>(-1234567890123, 0.5, "a \"b\"\n\x01", true, {{'A', 'B', 0, 0}}));
+    CHECK(writer.str() ==
+          "{\"id\":-1234567890123,\"price\":0.5,\"name\":\"a \\\"b\\\"\\n\\u0001\","
+          "\"bool\":true,\"code\":\"AB\"}");
+
+    writer.clear();
+    soa_vector<type_map<type_pair<MINIMPL_KEY("n"), unsigned>, type_pair<float, float>>> v;
+    v.push_back(0, 1.5f);
+    v.push_back(4294967295u, NAN);
+    writer.write_lines(v);
+    CHECK(writer.str() == "{\"n\":0,\"float\":1.5}\n{\"n\":4294967295,\"float\":null}\n");
+
+    writer.clear();
+    writer.write<type_map<>>(typed_record<type_map<>>());
+    CHECK(writer.str() == "{}");
+
+    char buffer[24];
+    CHECK(std::string(format_decimal(18446744073709551615ull, buffer + 24), buffer + 24) ==
+          "18446744073709551615");
+    CHECK(std::string(format_decimal(7, buffer + 24), buffer + 24) == "7");
+}
+
+TEST_CASE("compressed_column tests") {
+    uint64_t values[5] = {1, 0, 4095, 7, 2048}, words[4], decoded[5];
+    pack_bits(values, 5, 12, words);
+    unpack_bits(words, 5, 12, decoded);
+    CHECK(std::equal(values, values + 5, decoded));
+
+    using time = MINIMPL_KEY("time");
+    using level = MINIMPL_KEY("level");
+    using price = MINIMPL_KEY("price");
+    using value = MINIMPL_KEY("value");
+    using m = type_map<type_pair<time, delta<int64_t>>, type_pair<level, bitpacked<uint16_t, 4>>,
+                       type_pair<price, frame_of_reference<int32_t>>, type_pair<value, double>>;
+    compressed_vector<m> v;
+    const int n = 1000;
+    for (int i = 0; i < n; i++) {
+        v.push_back(1600000000000 + 10 * i - (i % 3), uint16_t(i % 16), -50000 + i % 100, i * 0.5);
+    }
+    REQUIRE(v.size() == n);
+    CHECK(v.get<time>(0) == 1600000000000);
+    CHECK(v.get<time>(700) == 1600000000000 + 7000 - 1);
+    CHECK(v.get<level>(999) == 7);
+    CHECK(v.get<price>(257) == -50000 + 57);
+    CHECK(v.get<value>(3) == 1.5);
+    CHECK(v.column<time>().block_count() == 4);
+    CHECK(v.column<time>().memory_usage() < n * sizeof(int64_t) / 2);
+    CHECK(v.column<level>().memory_usage() < n * sizeof(uint16_t) / 2);
+
+    int64_t sum = 0, expected = 0;
+    v.column<price>().for_each_block([&](const int32_t* block, size_t size) {
+        for (size_t i = 0; i < size; i++) { sum += block[i]; }
+    });
+    for (int i = 0; i < n; i++) { expected += -50000 + i % 100; }
+    CHECK(sum == expected);
+
+    double total = 0;
+    v.column<value>().for_each_block([&](const double* block, size_t size) {
+        for (size_t i = 0; i < size; i++) { total += block[i]; }
+    });
+    CHECK(total == 0.5 * n * (n - 1) / 2);
+
+    compressed_column<delta<int8_t>> extremes;
+    int8_t extreme_values[] = {-128, 127, -128, 0};
+    for (int8_t x : extreme_values) { extremes.push_back(x); }
+    for (int i = 0; i < 300; i++) { extremes.push_back(int8_t(i)); }
+    CHECK(extremes.get(1) == 127);
+    CHECK(extremes.get(2) == -128);
+    CHECK(extremes.get(303) == int8_t(299));
+
+    compressed_column<bitpacked<uint16_t, 4>> levels;
+    uint16_t level_values[] = {3, 17, 4};  // 17 does not fit on 4 bits
+    for (uint16_t x : level_values) { levels.push_back(x); }
+    for (size_t i = 3; i <= codec_block_size; i++) { levels.push_back(15); }
+    REQUIRE(levels.block_count() == 2);
+    CHECK(levels.get(0) == 3);
+    CHECK(levels.get(1) == 1);
+    CHECK(levels.get(2) == 4);
+    CHECK(levels.get(3) == 15);
+}
+
+TEST_CASE("column_convert tests") {
+    const size_t n = 37;  // not a multiple of any vector width
+    uint16_t u16[n];
+    uint32_t u32[n];
+    uint64_t u64[n];
+    float f[n];
+    double d[n];
+    int32_t i32[n];
+    int64_t i64[n];
+    int16_t i16[n];
+    for (size_t i = 0; i < n; i++) {
+        u16[i] = uint16_t(0x0102 * i);
+        u32[i] = uint32_t(0x01020304 * i);
+        u64[i] = 0x0102030405060708ull * i;
+        f[i] = float(i) + 0.5f;
+        i32[i] = int32_t(i) - 20;
+    }
+    byteswap_span(u16, u16, n);
+    byteswap_span(u32, u32, n);
+    byteswap_span(u64, u64, n);
+    for (size_t i = 0; i < n; i++) {
+        CHECK(u16[i] == byteswap(uint16_t(0x0102 * i)));
+        CHECK(u32[i] == byteswap(uint32_t(0x01020304 * i)));
+        CHECK(u64[i] == byteswap(0x0102030405060708ull * i));
+    }
+    std::array<char, 4> codes[n], copied[n];
+    for (size_t i = 0; i < n; i++) { codes[i] = {{'A', 'B', 'C', char(i)}}; }
+    byteswap_span(codes, copied, n);  // fixed-size strings have no byte order
+    byteswap_span(codes, codes, n);
+    CHECK(copied[9] == (std::array<char, 4>{{'A', 'B', 'C', 9}}));
+    CHECK(codes[36] == (std::array<char, 4>{{'A', 'B', 'C', 36}}));
+
+    convert_span(f, d, n);
+    convert_span(i32, i64, n);
+    convert_span(i64, i16, n);
+    CHECK(d[36] == 36.5);
+    CHECK(i64[0] == -20);
+    CHECK(i16[36] == 16);
+    convert_span(d, f, n);
+    CHECK(f[35] == 35.5f);
+
+    // every other int32 of a buffer, stored big-endian
+    unsigned char bytes[8 * n];
+    for (size_t i = 0; i < n; i++) {
+        store_bytes<int32_t, byte_order::big>(bytes + 8 * i, -int(i));
+    }
+    load_column<int32_t>(bytes, n, d, byte_order::big, 8);
+    CHECK(d[0] == 0);
+    CHECK(d[36] == -36);
+
+    using m = type_map<type_pair<int, int32_t>, type_pair<short, int16_t>>;
+    record_view<m, declared_layout, byte_order::big> view(bytes);
+    view.read_column<int>(n, i64);
+    CHECK(i64[5] == -5);
+
+    using code = MINIMPL_KEY("code");
+    soa_vector<type_map<type_pair<MINIMPL_KEY("x"), int32_t>, type_pair<float, float>,
+                        type_pair<code, std::array<char, 4>>>>
+        v;
+    for (int i = 0; i < 300; i++) { v.push_back(i - 100, i * 0.25f, {{'A', 'B', 'C', char(i)}}); }
+    const std::string path = "column_convert_test.bin";
+    byte_order other =
+        byte_order::native == byte_order::little ? byte_order::big : byte_order::little;
+    write_columnar(path, v, other);
+    {
+        columnar_file<decltype(v)::map> file(path);
+        CHECK(file.order() == other);
+        REQUIRE(file.size() == 300);
+        CHECK_THROWS_AS(file.column<float>(), std::runtime_error);
+        std::vector<int64_t> x(300);
+        file.read_column<MINIMPL_KEY("x")>(x.data());
+        CHECK(x[0] == -100);
+        CHECK(x[299] == 199);
+        std::vector<double> y(10);
+        file.read_column<float>(y.data(), 290, 10);
+        CHECK(y[9] == 299 * 0.25);
+        std::vector<std::array<char, 4>> codes(300);
+        file.read_column<code>(codes.data());  // fixed-size strings are not byte-swapped
+        CHECK(codes[7] == (std::array<char, 4>{{'A', 'B', 'C', 7}}));
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("normalized_key tests") {
+    auto encoded = [](auto value) {
+        std::array<unsigned char, key_encoder<decltype(value)>::size> bytes;
+        key_encoder<decltype(value)>::encode(value, bytes.data());
+        return bytes;
+    };
+    CHECK(encoded(-1) < encoded(0));
+    CHECK(encoded(int64_t(-5000000000)) < encoded(int64_t(-1)));
+    CHECK(encoded(255u) < encoded(256u));
+    CHECK(encoded(int8_t(127)) > encoded(int8_t(-128)));
+    CHECK(encoded(false) < encoded(true));
+    CHECK(encoded(-double(INFINITY)) < encoded(-1.5));
+    CHECK(encoded(-1.5) < encoded(-0.25));
+    CHECK(encoded(-0.f) < encoded(0.f));
+    CHECK(encoded(0.25f) < encoded(1e30f));
+    CHECK(encoded(1e300) < encoded(double(INFINITY)));
+    CHECK(encoded(std::array<char, 3>{{'a', 'b', 0}}) <
+          encoded(std::array<char, 3>{{'a', 'b', 'a'}}));
+
+    using name = MINIMPL_KEY("name");
+    using score = MINIMPL_KEY("score");
+    using id = MINIMPL_KEY("id");
+    using m = type_map<type_pair<id, int16_t>, type_pair<name, std::array<char, 4>>,
+                       type_pair<score, double>>;
+    using key = normalized_key<m, name, descending<score>, id>;
+    CHECK(key::size == 14);
+    std::vector<typed_record<m>> records = {{1, {{'b', 0, 0, 0}}, 2.5},
+                                            {2, {{'a', 0, 0, 0}}, -1.0},
+                                            {3, {{'a', 0, 0, 0}}, 7.0},
+                                            {-4, {{'a', 0, 0, 0}}, 7.0}};
+    std::sort(records.begin(), records.end(), [](const auto& a, const auto& b) {
+        return std::memcmp(key::encode(a).data(), key::encode(b).data(), key::size) < 0;
+    });
+    CHECK(records[0].get<id>() == -4);
+    CHECK(records[1].get<id>() == 3);
+    CHECK(records[2].get<id>() == 2);
+    CHECK(records[3].get<id>() == 1);
+}
+
+struct throwing_move {
+    static bool armed;
+    int value;
+    throwing_move(int value = 0) : value(value) {}
+    throwing_move(const throwing_move&) = default;
+    throwing_move(throwing_move&& other) : value(other.value) {
+        if (armed) { throw std::runtime_error("move"); }
+    }
+    throwing_move& operator=(const throwing_move&) = default;
+};
+bool throwing_move::armed = false;
+
+TEST_CASE("soa_sort tests") {
+    struct id {};
+    struct score {};
+    struct group {};
+    using m = type_map<type_pair<id, int>, type_pair<score, double>, type_pair<group, int64_t>>;
+    soa_vector<m> v;
+    v.push_back(0, 2.5, -300);
+    v.push_back(1, -1.0, 70000);
+    v.push_back(2, 7.0, -300);
+    v.push_back(3, 2.5, 5);
+    v.push_back(4, 7.0, -300);
+
+    CHECK(radix_sort_permutation<group>(v) == (std::vector<size_t>{0, 2, 4, 3, 1}));  // stable
+    radix_sort<group, descending<score>>(v);
+    std::vector<int> ids, expected = {2, 4, 0, 3, 1};
+    for (size_t i = 0; i < v.size(); i++) { ids.push_back(v.get<id>(i)); }
+    CHECK(ids == expected);
+    CHECK(v.get<score>(0) == 7.0);
+    CHECK(v.get<group>(4) == 70000);
+
+    radix_sort<id>(v, execution::parallel);
+    for (size_t i = 0; i < v.size(); i++) { CHECK(v.get<id>(i) == int(i)); }
+    CHECK(v.get<score>(1) == -1.0);
+    CHECK(v.get<group>(3) == 5);
+
+    soa_vector<m> empty;
+    radix_sort<score, id>(empty);
+    CHECK(empty.size() == 0);
+
+    soa_vector<type_map<type_pair<id, int>, type_pair<std::string, std::string>>> names;
+    names.push_back(2, std::string(40, 'b'));
+    names.push_back(1, "a");
+    radix_sort<id>(names);
+    CHECK(names.get<std::string>(0) == "a");
+    CHECK(names.get<std::string>(1) == std::string(40, 'b'));
+
+    CHECK_THROWS_AS(apply_permutation(v, {0, 1, 2}), std::invalid_argument);
+    CHECK_THROWS_AS(apply_permutation(v, {0, 1, 2, 3, 5}, execution::parallel),
+                    std::invalid_argument);
+    for (size_t i = 0; i < v.size(); i++) { CHECK(v.get<id>(i) == int(i)); }
+
+    soa_vector<type_map<type_pair<id, int>, type_pair<score, throwing_move>>> rows;
+    rows.push_back(1, 10);
+    rows.push_back(0, 20);
+    throwing_move::armed = true;
+    CHECK_THROWS_AS(radix_sort<id>(rows, execution::parallel), std::runtime_error);
+    CHECK_THROWS_AS(radix_sort<id>(rows), std::runtime_error);
+    CHECK(rows.size() == 2);
+    throwing_move::armed = false;
+}
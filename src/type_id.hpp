@@ -0,0 +1,107 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "type_list.hpp"
+
+class const_string {
+    const char* data_{""};
+    size_t size_{0};
+
+  public:
+    constexpr const_string() = default;
+    constexpr const_string(const char* data, size_t size) : data_(data), size_(size) {}
+    template <size_t n>
+    constexpr const_string(const char (&literal)[n]) : data_(literal), size_(n - 1) {}
+    const_string(const std::string& s) : data_(s.data()), size_(s.size()) {}
+
+    constexpr const char* data() const { return data_; }
+    constexpr size_t size() const { return size_; }
+    constexpr char operator[](size_t i) const { return data_[i]; }
+    constexpr const char* begin() const { return data_; }
+    constexpr const char* end() const { return data_ + size_; }
+    std::string str() const { return std::string(data_, size_); }
+
+    constexpr size_t find(const_string s, size_t from = 0) const {
+        for (size_t i = from; i + s.size_ <= size_; i++) {
+            size_t j = 0;
+            while (j < s.size_ and data_[i + j] == s.data_[j]) { j++; }
+            if (j == s.size_) { return i; }
+        }
+        return size_;
+    }
+
+    constexpr const_string substr(size_t begin, size_t end) const {
+        return const_string(data_ + begin, end - begin);
+    }
+};
+
+constexpr bool operator==(const_string a, const_string b) {
+    if (a.size() != b.size()) { return false; }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i] != b[i]) { return false; }
+    }
+    return true;
+}
+
+constexpr bool operator!=(const_string a, const_string b) { return not(a == b); }
+
+constexpr uint64_t fnv1a(const_string s, uint64_t hash = 14695981039346656037ull) {
+    for (size_t i = 0; i < s.size(); i++) {
+        hash = (hash ^ uint64_t(static_cast<unsigned char>(s[i]))) * 1099511628211ull;
+    }
+    return hash;
+}
+
+//==================================================================================================
+template <class T>
+constexpr const_string type_name() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    constexpr const_string signature(__FUNCSIG__);
+    constexpr const_string prefix("type_name<");
+    constexpr size_t begin = signature.find(prefix) + prefix.size();
+    return signature.substr(begin, signature.find(">(void)", begin));
+#else
+    // gcc: "... type_name() [with T = int]", clang: "... type_name() [T = int]"
+    constexpr const_string signature(__PRETTY_FUNCTION__);
+    constexpr const_string prefix("T = ");
+    return signature.substr(signature.find(prefix) + prefix.size(), signature.size() - 1);
+#endif
+}
+
+template <class T>
+constexpr uint64_t type_id() {
+    return fnv1a(type_name<T>());
+}
+
+template <class T>
+using type_id_constant = std::integral_constant<uint64_t, type_id<T>()>;
+
+template <class L>
+using list_type_ids = list_map_to_value<type_id_constant, uint64_t, L>;
@@ -26,7 +26,11 @@ license and that you accept its terms.*/
 
 #pragma once
 
+#include <array>
+#include <functional>
+#include <stdexcept>
 #include <tuple>
+#include <utility>
 #include "is_type.hpp"
 
 template <class... Ts>
@@ -44,6 +48,34 @@ using list_element_t = std::tuple_element_t<i, T>;
 template <size_t i>
 using index_constant = std::integral_constant<size_t, i>;
 
+template <size_t i, class T>
+struct indexed_type : is_type<T> {};
+
+template <class Seq, class... Ts>
+struct indexed_pack;
+
+template <size_t... Is, class... Ts>
+struct indexed_pack<std::index_sequence<Is...>, Ts...> : indexed_type<Is, Ts>... {};
+
+template <size_t i, class T>
+indexed_type<i, T> select_indexed(const indexed_type<i, T>&);
+
+// constant-depth alternative to list_element for long packs
+template <size_t i, class... Ts>
+using pack_element =
+    decltype(select_indexed<i>(indexed_pack<std::index_sequence_for<Ts...>, Ts...>()));
+
+template <size_t i, class... Ts>
+using pack_element_t = is_type_t<pack_element<i, Ts...>>;
+
+template <size_t n>
+constexpr size_t first_true(const std::array<bool, n>& a) {
+    for (size_t i = 0; i < n; i++) {
+        if (a[i]) { return i; }
+    }
+    return n;
+}
+
 //==================================================================================================
 template <class T>
 struct is_list : std::false_type {};
@@ -103,6 +135,22 @@ template <template <class> class F, class First, class... Rest>
 struct list_map<F, type_list<First, Rest...>>
     : list_push_front<F<First>, list_map_t<F, type_list<Rest...>>> {};
 
+//==================================================================================================
+template <template <class> class F, class T>
+struct list_filter;
+
+template <template <class> class F, class T>
+using list_filter_t = is_type_t<list_filter<F, T>>;
+
+template <template <class> class F>
+struct list_filter<F, type_list<>> : is_type<type_list<>> {};
+
+template <template <class> class F, class First, class... Rest>
+struct list_filter<F, type_list<First, Rest...>>
+    : std::conditional_t<F<First>::value,
+                         list_push_front<First, list_filter_t<F, type_list<Rest...>>>,
+                         list_filter<F, type_list<Rest...>>> {};
+
 //==================================================================================================
 template <template <class> class F, class ValueT, class List>
 struct list_map_to_value;
@@ -138,4 +186,39 @@ template <template <class> class F, class L>
 using list_and = list_reduce_to_value<F, std::logical_and<bool>, bool, true, L>;
 
 template <template <class> class F, class L>
-using list_or = list_reduce_to_value<F, std::logical_or<bool>, bool, false, L>;
\ No newline at end of file
+using list_or = list_reduce_to_value<F, std::logical_or<bool>, bool, false, L>;
+
+//==================================================================================================
+template <class T, class R, class F>
+R list_visit_call(F& f) {
+    return f(is_type<T>());
+}
+
+template <class L, class F>
+struct list_visit_result;
+
+template <class First, class... Rest, class F>
+struct list_visit_result<type_list<First, Rest...>, F>
+    : is_type<decltype(std::declval<F&>()(is_type<First>()))> {};
+
+template <class L, class F>
+struct list_visitor;
+
+template <class... Ts, class F>
+struct list_visitor<type_list<Ts...>, F> {
+    using result = is_type_t<list_visit_result<type_list<Ts...>, F>>;
+    using function = result (*)(F&);
+    static constexpr function table[sizeof...(Ts)] = {&list_visit_call<Ts, result, F>...};
+};
+
+template <class... Ts, class F>
+constexpr typename list_visitor<type_list<Ts...>, F>::function
+    list_visitor<type_list<Ts...>, F>::table[sizeof...(Ts)];
+
+// calls f(is_type<T>()) for the i-th element T of L, throws std::out_of_range if there is none (for
+// instance when i is the size returned by a failed lookup)
+template <class L, class F>
+typename list_visitor<L, std::remove_reference_t<F>>::result list_visit(size_t i, F&& f) {
+    if (i >= list_size<L>::value) { throw std::out_of_range("list_visit: index out of range"); }
+    return list_visitor<L, std::remove_reference_t<F>>::table[i](f);
+}
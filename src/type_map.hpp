@@ -41,6 +41,25 @@ struct is_map<type_list<type_pair<T, U>, Rest...>> : is_map<type_list<Rest...>>
 template <>
 struct is_map<type_list<>> : std::true_type {};
 
+//==================================================================================================
+template <class Key, class KeyList>
+struct map_key_find;
+
+template <class Key, class... Ks>
+struct map_key_find<Key, type_list<Ks...>>
+    : index_constant<first_true(
+          std::array<bool, sizeof...(Ks)>{{std::is_same<Key, Ks>::value...}})> {};
+
+template <class Key, class T, size_t index = 0>
+struct map_element_index;
+
+template <class Key, class... Ks, class... Vs, size_t index>
+struct map_element_index<Key, type_map<type_pair<Ks, Vs>...>, index>
+    : index_constant<index + map_key_find<Key, type_list<Ks...>>::value> {
+    static_assert(map_key_find<Key, type_list<Ks...>>::value < sizeof...(Ks),
+                  "key not found in map");
+};
+
 //==================================================================================================
 template <class Key, class T>
 struct map_element;
@@ -48,12 +67,9 @@ struct map_element;
 template <class Key, class T>
 using map_element_t = is_type_t<map_element<Key, T>>;
 
-template <class Key, class T, class U, class... Rest>
-struct map_element<Key, type_map<type_pair<T, U>, Rest...>> : map_element<Key, type_map<Rest...>> {
-};
-
-template <class Key, class T, class... Rest>
-struct map_element<Key, type_map<type_pair<Key, T>, Rest...>> : is_type<T> {};
+template <class Key, class... Ks, class... Vs>
+struct map_element<Key, type_map<type_pair<Ks, Vs>...>>
+    : pack_element<map_element_index<Key, type_map<type_pair<Ks, Vs>...>>::value, Vs...> {};
 
 //==================================================================================================
 template <class Key, class Value, class T>
@@ -62,18 +78,6 @@ using map_push_front = list_push_front<type_pair<Key, Value>, T>;
 template <class Key, class Value, class T>
 using map_push_front_t = list_push_front_t<type_pair<Key, Value>, T>;
 
-//==================================================================================================
-template <class Key, class T, size_t index = 0>
-struct map_element_index;
-
-template <class Key, class T, class U, size_t index, class... Rest>
-struct map_element_index<Key, type_map<type_pair<T, U>, Rest...>, index>
-    : map_element_index<Key, type_map<Rest...>, index + 1> {};
-
-template <class Key, class T, size_t index, class... Rest>
-struct map_element_index<Key, type_map<type_pair<Key, T>, Rest...>, index> : index_constant<index> {
-};
-
 //==================================================================================================
 template <class T>
 using map_value_list = list_map<second_t, T>;
@@ -0,0 +1,84 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include "cold.hpp"
+#include "compact_tuple.hpp"
+#include "record_storage.hpp"
+#include "type_map.hpp"
+
+struct declared_layout {
+    template <class L>
+    using storage = list_record_storage_t<L>;
+};
+
+struct compact_layout {
+    template <class L>
+    using storage = compact_tuple<L>;
+};
+
+//==================================================================================================
+template <class M, class Layout = declared_layout>
+struct typed_record;
+
+template <class Layout>
+struct typed_record<type_map<>, Layout> {
+    using map = type_map<>;
+    record_storage<> data;
+};
+
+template <class... Keys, class... Values, class Layout>
+struct typed_record<type_map<type_pair<Keys, Values>...>, Layout> {
+    using map = type_map<type_pair<Keys, Values>...>;
+    typename Layout::template storage<type_list<uncold_t<Values>...>> data;
+
+    typed_record() = default;
+    constexpr typed_record(const uncold_t<Values>&... values) : data(values...) {}
+
+    template <class Key>
+    constexpr auto& get() {
+        return ::get<map_element_index<Key, map>::value>(data);
+    }
+
+    template <class Key>
+    constexpr const auto& get() const {
+        return ::get<map_element_index<Key, map>::value>(data);
+    }
+};
+
+template <class M>
+using compact_record = typed_record<M, compact_layout>;
+
+template <class Key, class M, class Layout>
+constexpr auto& get(typed_record<M, Layout>& r) {
+    return r.template get<Key>();
+}
+
+template <class Key, class M, class Layout>
+constexpr const auto& get(const typed_record<M, Layout>& r) {
+    return r.template get<Key>();
+}
@@ -0,0 +1,204 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <utility>
+#include "type_list.hpp"
+
+template <class T, T... Vs>
+struct value_list {
+    using value_type = T;
+    static constexpr size_t size = sizeof...(Vs);
+    static constexpr std::array<T, sizeof...(Vs)> value = {{Vs...}};
+};
+
+template <class T, T... Vs>
+constexpr size_t value_list<T, Vs...>::size;
+
+template <class T, T... Vs>
+constexpr std::array<T, sizeof...(Vs)> value_list<T, Vs...>::value;
+
+template <size_t... Is>
+using index_list = value_list<size_t, Is...>;
+
+template <class T>
+struct is_value_list : std::false_type {};
+
+template <class T, T... Vs>
+struct is_value_list<value_list<T, Vs...>> : std::true_type {};
+
+// std::array cannot be modified in C++14 constant expressions, this can
+template <class T, size_t n>
+struct value_array {
+    T data[n == 0 ? 1 : n];
+
+    constexpr T& operator[](size_t i) { return data[i]; }
+    constexpr const T& operator[](size_t i) const { return data[i]; }
+    static constexpr size_t size() { return n; }
+};
+
+//==================================================================================================
+template <class T, class Seq>
+struct value_list_from_sequence;
+
+template <class T, class Seq>
+using value_list_from_sequence_t = is_type_t<value_list_from_sequence<T, Seq>>;
+
+template <class T, class U, U... Vs>
+struct value_list_from_sequence<T, std::integer_sequence<U, Vs...>>
+    : is_type<value_list<T, T(Vs)...>> {};
+
+template <class L>
+struct value_list_to_sequence;
+
+template <class L>
+using value_list_to_sequence_t = is_type_t<value_list_to_sequence<L>>;
+
+template <class T, T... Vs>
+struct value_list_to_sequence<value_list<T, Vs...>> : is_type<std::integer_sequence<T, Vs...>> {};
+
+// builds a value_list from a generator with a static constexpr array member value
+template <class T, class Gen, class Seq = std::make_index_sequence<Gen::size>>
+struct value_list_generate;
+
+template <class T, class Gen>
+using value_list_generate_t = is_type_t<value_list_generate<T, Gen>>;
+
+template <class T, class Gen, size_t... Is>
+struct value_list_generate<T, Gen, std::index_sequence<Is...>>
+    : is_type<value_list<T, Gen::value[Is]...>> {};
+
+//==================================================================================================
+template <class T, size_t n>
+constexpr size_t value_find(const std::array<T, n>& a, T v) {
+    for (size_t i = 0; i < n; i++) {
+        if (a[i] == v) { return i; }
+    }
+    return n;
+}
+
+template <class L, typename L::value_type v>
+using value_list_find = index_constant<value_find(L::value, v)>;
+
+template <class L, typename L::value_type v>
+using value_list_contains = std::integral_constant<bool, (value_find(L::value, v) < L::size)>;
+
+//==================================================================================================
+template <class F, class L>
+struct value_list_map;
+
+template <class F, class L>
+using value_list_map_t = is_type_t<value_list_map<F, L>>;
+
+template <class F, class T, T... Vs>
+struct value_list_map<F, value_list<T, Vs...>>
+    : is_type<value_list<decltype(F()(std::declval<T>())), F()(Vs)...>> {};
+
+//==================================================================================================
+template <class Combinator, class L, typename L::value_type Zero>
+struct value_list_reduce {
+    using T = typename L::value_type;
+
+    static constexpr T reduce() {
+        T result = Zero;
+        for (size_t i = 0; i < L::size; i++) { result = Combinator()(result, L::value[i]); }
+        return result;
+    }
+
+    static constexpr T value = reduce();
+};
+
+template <class Combinator, class L, typename L::value_type Zero>
+constexpr typename L::value_type value_list_reduce<Combinator, L, Zero>::value;
+
+template <class L>
+using value_list_sum = value_list_reduce<std::plus<typename L::value_type>, L, 0>;
+
+//==================================================================================================
+template <class... Ls>
+struct value_list_concat;
+
+template <class... Ls>
+using value_list_concat_t = is_type_t<value_list_concat<Ls...>>;
+
+template <class T, T... Vs>
+struct value_list_concat<value_list<T, Vs...>> : is_type<value_list<T, Vs...>> {};
+
+template <class T, T... Vs, T... Us, class... Rest>
+struct value_list_concat<value_list<T, Vs...>, value_list<T, Us...>, Rest...>
+    : value_list_concat<value_list<T, Vs..., Us...>, Rest...> {};
+
+//==================================================================================================
+template <size_t begin, size_t end, class L, class Seq = std::make_index_sequence<end - begin>>
+struct value_list_slice;
+
+template <size_t begin, size_t end, class L>
+using value_list_slice_t = is_type_t<value_list_slice<begin, end, L>>;
+
+template <size_t begin, size_t end, class T, T... Vs, size_t... Is>
+struct value_list_slice<begin, end, value_list<T, Vs...>, std::index_sequence<Is...>>
+    : is_type<value_list<T, value_list<T, Vs...>::value[begin + Is]...>> {
+    static_assert(begin <= end and end <= sizeof...(Vs), "invalid slice bounds");
+};
+
+//==================================================================================================
+// stable bottom-up merge sort
+template <class T, size_t n, class Compare>
+constexpr value_array<T, n> value_sort(const std::array<T, n>& input, Compare compare) {
+    value_array<T, n> a{}, tmp{};
+    for (size_t i = 0; i < n; i++) { a[i] = input[i]; }
+    for (size_t width = 1; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = lo + width < n ? lo + width : n;
+            size_t hi = lo + 2 * width < n ? lo + 2 * width : n;
+            size_t i = lo, j = mid, k = lo;
+            while (i < mid and j < hi) { tmp[k++] = compare(a[j], a[i]) ? a[j++] : a[i++]; }
+            while (i < mid) { tmp[k++] = a[i++]; }
+            while (j < hi) { tmp[k++] = a[j++]; }
+        }
+        for (size_t i = 0; i < n; i++) { a[i] = tmp[i]; }
+    }
+    return a;
+}
+
+template <class L, class Compare>
+struct value_list_sorted {
+    static constexpr size_t size = L::size;
+    static constexpr value_array<typename L::value_type, L::size> value =
+        value_sort(L::value, Compare());
+};
+
+template <class L, class Compare>
+constexpr value_array<typename L::value_type, L::size> value_list_sorted<L, Compare>::value;
+
+template <class L, class Compare = std::less<typename L::value_type>>
+using value_list_sort = value_list_generate<typename L::value_type, value_list_sorted<L, Compare>>;
+
+template <class L, class Compare = std::less<typename L::value_type>>
+using value_list_sort_t = is_type_t<value_list_sort<L, Compare>>;
@@ -0,0 +1,199 @@
+/*Copyright or © or Copr. CNRS (2019). Contributors:
+- Vincent Lanore. vincent.lanore@gmail.com
+
+This software is a computer program whose purpose is to provide a header-only library with simple
+template metaprogramming datastructures (list, map) and utilities.
+
+This software is governed by the CeCILL-C license under French law and abiding by the rules of
+distribution of free software. You can use, modify and/ or redistribute the software under the terms
+of the CeCILL-C license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info".
+
+As a counterpart to the access to the source code and rights to copy, modify and redistribute
+granted by the license, users are provided only with a limited warranty and the software's author,
+the holder of the economic rights, and the successive licensors have only limited liability.
+
+In this respect, the user's attention is drawn to the risks associated with loading, using,
+modifying and/or developing or reproducing the software by the user in light of its specific status
+of free software, that may mean that it is complicated to manipulate, and that also therefore means
+that it is reserved for developers and experienced professionals having in-depth computer knowledge.
+Users are therefore encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or data to be ensured and,
+more generally, to use and operate it in the same conditions as regards security.
+
+The fact that you are presently reading this means that you have had knowledge of the CeCILL-C
+license and that you accept its terms.*/
+
+#pragma once
+
+#include <cstdint>
+#include "type_map.hpp"
+
+// Keys of value maps, distinct from std::integral_constant so that the value key lookup below
+// does not change the lookup of integral_constant keys in other maps.
+template <class T, T v>
+struct value_key : std::integral_constant<T, v> {};
+
+#if defined(__cpp_nontype_template_parameter_auto) && \
+    __cpp_nontype_template_parameter_auto >= 201606L
+template <auto v>
+using vkey = value_key<decltype(v), v>;
+#endif
+
+template <class T, T v, class Value>
+using value_pair = type_pair<value_key<T, v>, Value>;
+
+template <class... Pairs>
+using value_map = type_map<Pairs...>;
+
+template <class T, class Key>
+struct value_key_of : std::integral_constant<int64_t, 0> {
+    static constexpr bool is_key = false;
+};
+
+template <class T, T v>
+struct value_key_of<T, value_key<T, v>>
+    : std::integral_constant<int64_t, static_cast<int64_t>(v)> {
+    static constexpr bool is_key = true;
+};
+
+//==================================================================================================
+template <size_t n>
+constexpr int64_t value_keys_bound(const std::array<bool, n>& is_key,
+                                   const std::array<int64_t, n>& values, bool upper) {
+    int64_t result = 0;
+    bool first = true;
+    for (size_t i = 0; i < n; i++) {
+        if (is_key[i] and (first or (upper ? values[i] > result : values[i] < result))) {
+            result = values[i];
+            first = false;
+        }
+    }
+    return result;
+}
+
+template <size_t n>
+constexpr size_t value_keys_find(const std::array<bool, n>& is_key,
+                                 const std::array<int64_t, n>& values, int64_t v) {
+    for (size_t i = 0; i < n; i++) {
+        if (is_key[i] and values[i] == v) { return i; }
+    }
+    return n;
+}
+
+template <size_t n, size_t... Is>
+constexpr std::array<size_t, sizeof...(Is)> value_keys_slots(const std::array<bool, n>& is_key,
+                                                             const std::array<int64_t, n>& values,
+                                                             int64_t min,
+                                                             std::index_sequence<Is...>) {
+    return {{value_keys_find(is_key, values, min + int64_t(Is))...}};
+}
+
+// Keys of type value_key<T, v> are mapped to slot v - min of a dense table, unless
+// they are too spread out, in which case lookups fall back to a linear search.
+template <class T, class KeyList>
+struct value_key_slots;
+
+template <class T, class... Ks>
+struct value_key_slots<T, type_list<Ks...>> {
+    static constexpr size_t size = sizeof...(Ks);
+    static constexpr std::array<bool, sizeof...(Ks)> is_key = {{value_key_of<T, Ks>::is_key...}};
+    static constexpr std::array<int64_t, sizeof...(Ks)> values = {{value_key_of<T, Ks>::value...}};
+    static constexpr int64_t min = value_keys_bound(is_key, values, false);
+    static constexpr size_t range = size_t(value_keys_bound(is_key, values, true) - min) + 1;
+    static constexpr bool dense = range <= 2 * size + 64;
+    static constexpr std::array<size_t, dense ? range : 0> slots =
+        value_keys_slots(is_key, values, min, std::make_index_sequence<dense ? range : 0>());
+
+    // returns the index of key v, or the number of keys if there is none
+    static constexpr size_t find(T v) {
+        int64_t key = static_cast<int64_t>(v);
+        if (not dense) { return value_keys_find(is_key, values, key); }
+        if (key < min or size_t(key - min) >= range) { return size; }
+        return slots[size_t(key - min)];
+    }
+};
+
+template <class T, class... Ks>
+constexpr std::array<bool, sizeof...(Ks)> value_key_slots<T, type_list<Ks...>>::is_key;
+
+template <class T, class... Ks>
+constexpr std::array<int64_t, sizeof...(Ks)> value_key_slots<T, type_list<Ks...>>::values;
+
+template <class T, class... Ks>
+constexpr int64_t value_key_slots<T, type_list<Ks...>>::min;
+
+template <class T, class... Ks>
+constexpr size_t value_key_slots<T, type_list<Ks...>>::range;
+
+template <class T, class... Ks>
+constexpr bool value_key_slots<T, type_list<Ks...>>::dense;
+
+template <class T, class... Ks>
+constexpr size_t value_key_slots<T, type_list<Ks...>>::size;
+
+template <class T, class... Ks>
+constexpr std::array<size_t, value_key_slots<T, type_list<Ks...>>::dense
+                                 ? value_key_slots<T, type_list<Ks...>>::range
+                                 : 0>
+    value_key_slots<T, type_list<Ks...>>::slots;
+
+template <class T, T v, class... Ks>
+struct map_key_find<value_key<T, v>, type_list<Ks...>>
+    : index_constant<value_key_slots<T, type_list<Ks...>>::find(v)> {};
+
+//==================================================================================================
+template <class M>
+using value_map_key_t = typename first_t<list_element_t<0, M>>::value_type;
+
+template <class M>
+using value_map_slots = value_key_slots<value_map_key_t<M>, map_key_list_t<M>>;
+
+template <class M>
+size_t value_map_find(value_map_key_t<M> v) {
+    return value_map_slots<M>::find(v);
+}
+
+// calls f(is_type<Value>()) for the value type of key v, throws std::out_of_range if v is not a key
+// of M (runtime values may come from outside of the program)
+template <class M, class F>
+auto value_map_visit(value_map_key_t<M> v, F&& f) {
+    return list_visit<map_value_list_t<M>>(value_map_find<M>(v), std::forward<F>(f));
+}
+
+// same, returns fallback() if v is not a key of M
+template <class M, class F, class Fallback>
+auto value_map_visit(value_map_key_t<M> v, F&& f, Fallback&& fallback) {
+    size_t i = value_map_find<M>(v);
+    return i < list_size<M>::value ? list_visit<map_value_list_t<M>>(i, std::forward<F>(f))
+                                   : fallback();
+}
+
+template <class ValueT, size_t n, size_t m, size_t... Is>
+constexpr std::array<ValueT, sizeof...(Is)> value_keys_table(const std::array<size_t, n>& slots,
+                                                             const std::array<ValueT, m>& values,
+                                                             std::index_sequence<Is...>) {
+    return {{(slots[Is] < m ? values[slots[Is]] : ValueT{})...}};
+}
+
+// table of F<Value>::value indexed by key value - min, holes are value-initialized
+template <template <class> class F, class ValueT, class M>
+struct value_map_to_value {
+    using slots = value_map_slots<M>;
+    static_assert(slots::dense, "value keys are too sparse for a dense table");
+
+    static constexpr std::array<ValueT, slots::range> value =
+        value_keys_table(slots::slots, list_map_to_value<F, ValueT, map_value_list_t<M>>::value,
+                         std::make_index_sequence<slots::range>());
+
+    // value-initialized for keys outside of the table
+    static constexpr ValueT at(value_map_key_t<M> v) {
+        return static_cast<int64_t>(v) < slots::min or
+                       size_t(static_cast<int64_t>(v) - slots::min) >= slots::range
+                   ? ValueT{}
+                   : value[size_t(static_cast<int64_t>(v) - slots::min)];
+    }
+};
+
+template <template <class> class F, class ValueT, class M>
+constexpr std::array<ValueT, value_map_slots<M>::range> value_map_to_value<F, ValueT, M>::value;